@@ -0,0 +1,165 @@
+// @(#)root/hist:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2018, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TH1ConcurrentFill
+#define ROOT_TH1ConcurrentFill
+
+#include "TH1.h"
+#include "TH3.h"
+
+#include <algorithm>
+#include <mutex>
+
+namespace ROOT {
+
+template <int SIZE>
+class TH1ConcurrentFillManager;
+
+/**
+ \class ROOT::TH1ConcurrentFiller
+ \ingroup Hist
+ Buffers the Fill calls of one thread and submits them in bulk to the
+ TH1ConcurrentFillManager of a shared histogram.
+
+ A filler must only be used by one thread. The buffer is flushed when it is
+ full, when Flush() is called and when the filler is destroyed.
+
+ As for the histogram itself, the meaning of the Fill arguments depends on
+ the dimension of the histogram: Fill(x, y) fills x with weight y into a 1D
+ histogram and (x, y) with weight 1 into a 2D or 3D histogram.
+ **/
+
+template <int SIZE>
+class TH1ConcurrentFiller {
+   TH1ConcurrentFillManager<SIZE> &fManager;
+   Int_t fDim; ///< dimension of the histogram
+   Double_t fX[SIZE];
+   Double_t fY[SIZE];
+   Double_t fZ[SIZE];
+   Double_t fW[SIZE];
+   Int_t fN = 0;
+
+   void Add(Double_t x, Double_t y, Double_t z, Double_t w)
+   {
+      fX[fN] = x;
+      fY[fN] = y;
+      fZ[fN] = z;
+      fW[fN] = w;
+      if (++fN == SIZE)
+         Flush();
+   }
+
+public:
+   TH1ConcurrentFiller(TH1ConcurrentFillManager<SIZE> &manager) : fManager(manager), fDim(manager.fDim) {}
+   TH1ConcurrentFiller(const TH1ConcurrentFiller &) = delete;
+   TH1ConcurrentFiller(TH1ConcurrentFiller &&other) : fManager(other.fManager), fDim(other.fDim), fN(other.fN)
+   {
+      std::copy(other.fX, other.fX + fN, fX);
+      std::copy(other.fY, other.fY + fN, fY);
+      std::copy(other.fZ, other.fZ + fN, fZ);
+      std::copy(other.fW, other.fW + fN, fW);
+      other.fN = 0;
+   }
+   TH1ConcurrentFiller &operator=(const TH1ConcurrentFiller &) = delete;
+   ~TH1ConcurrentFiller() { Flush(); }
+
+   /// Thread-specific TH1::Fill(x).
+   void Fill(Double_t x) { Add(x, 0., 0., 1.); }
+
+   /// Thread-specific TH1::Fill(x, w) for 1D histograms and TH2::Fill(x, y) otherwise.
+   void Fill(Double_t x, Double_t y)
+   {
+      if (fDim == 1)
+         Add(x, 0., 0., y);
+      else
+         Add(x, y, 0., 1.);
+   }
+
+   /// Thread-specific TH2::Fill(x, y, w) for 2D histograms and TH3::Fill(x, y, z) otherwise.
+   void Fill(Double_t x, Double_t y, Double_t z)
+   {
+      if (fDim == 2)
+         Add(x, y, 0., z);
+      else
+         Add(x, y, z, 1.);
+   }
+
+   /// Thread-specific TH3::Fill(x, y, z, w).
+   void Fill(Double_t x, Double_t y, Double_t z, Double_t w) { Add(x, y, z, w); }
+
+   /// Submit the buffered entries to the histogram.
+   void Flush()
+   {
+      if (fN > 0)
+         fManager.FillN(fN, fX, fY, fZ, fW);
+      fN = 0;
+   }
+
+   TH1 &GetHist() { return fManager.GetHist(); }
+};
+
+/**
+ \class ROOT::TH1ConcurrentFillManager
+ \ingroup Hist
+ Allows several threads to fill a single histogram of the TH1 family.
+
+ Instead of giving every thread its own copy of the histogram, as
+ ROOT::TThreadedObject does, each thread gets a TH1ConcurrentFiller from
+ MakeFiller() that buffers up to SIZE entries. Full buffers are filled into
+ the shared histogram with TH1::FillN under a lock. The memory used therefore
+ does not grow with the number of bins times the number of threads, which
+ matters for large TH2, TH3 and variable-bin histograms.
+
+ Example:
+ ~~~ {.cpp}
+ TH3D h("h", "h", 200, 0, 1, 200, 0, 1, 200, 0, 1);
+ ROOT::TH1ConcurrentFillManager<> manager(h);
+ auto work = [&]() {
+    auto filler = manager.MakeFiller();
+    for (...)
+       filler.Fill(x, y, z, w);
+ };
+ ~~~
+ The histogram must not be accessed directly while fillers are active.
+ **/
+
+template <int SIZE = 1024>
+class TH1ConcurrentFillManager {
+   friend class TH1ConcurrentFiller<SIZE>;
+
+   TH1 &fHist;
+   TH3 *fHist3;           ///< fHist as a TH3, since TH3 has no FillN
+   Int_t fDim;            ///< dimension of the histogram
+   std::mutex fFillMutex; ///< serializes the FillN calls
+
+   void FillN(Int_t n, const Double_t *x, const Double_t *y, const Double_t *z, const Double_t *w)
+   {
+      std::lock_guard<std::mutex> lockGuard(fFillMutex);
+      if (fDim == 1) {
+         fHist.FillN(n, x, w);
+      } else if (fDim == 2) {
+         fHist.FillN(n, x, y, w, 1);
+      } else if (fHist3) {
+         for (Int_t i = 0; i < n; ++i)
+            fHist3->Fill(x[i], y[i], z[i], w[i]);
+      }
+   }
+
+public:
+   TH1ConcurrentFillManager(TH1 &hist) : fHist(hist), fHist3(dynamic_cast<TH3 *>(&hist)), fDim(hist.GetDimension()) {}
+
+   TH1ConcurrentFiller<SIZE> MakeFiller() { return TH1ConcurrentFiller<SIZE>{*this}; }
+
+   TH1 &GetHist() { return fHist; }
+};
+
+} // namespace ROOT
+
+#endif
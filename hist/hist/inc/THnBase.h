@@ -147,6 +147,7 @@ private:
       FillBin(bin, w);
       return bin;
    }
+   void FillN(Long64_t nEntries, const Double_t *x, const Double_t *w = 0);
    Long64_t Fill(const char* name[], Double_t w = 1.) {
       Long64_t bin = GetBin(name, kTRUE /*alloc*/);
       FillBin(bin, w);
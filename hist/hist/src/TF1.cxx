@@ -1425,6 +1425,67 @@ Double_t TF1::EvalPar(const Double_t *x, const Double_t *params)
    return result;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluate the function at n points and store the values in result[0..n-1].
+/// The coordinates are given per dimension: x[j * n + i] is coordinate j of
+/// point i. If params is 0 the current parameters are used.
+///
+/// Formula based functions made vectorized with SetVectorized() and functions
+/// created from a callable taking ROOT::Double_v are evaluated in chunks of
+/// the SIMD vector size; all others are evaluated point by point.
+/// Objects of classes deriving from TF1 are always evaluated point by point
+/// through EvalPar(), which they may override (e.g. TF12).
+
+void TF1::EvalN(Int_t n, const Double_t *x, Double_t *result, const Double_t *params)
+{
+   if (n <= 0)
+      return;
+
+   const Bool_t bulk = (IsA() == TF1::Class());
+
+   if (bulk && fType == EFType::kFormula) {
+      assert(fFormula);
+      fFormula->EvalN(n, x, result, params);
+   }
+#ifdef R__HAS_VECCORE
+   else if (bulk && fType == EFType::kTemplVec && fFunctor) {
+      if (!params) params = (Double_t *)fParams->GetParameters();
+      auto &fcn = ((TF1FunctorPointerImpl<ROOT::Double_v> *)fFunctor)->fImpl;
+      const Int_t vecSize = vecCore::VectorSize<ROOT::Double_v>();
+      std::vector<ROOT::Double_v> xvec(fNdim);
+      for (Int_t i = 0; i < n; i += vecSize) {
+         const Int_t nInVec = TMath::Min(vecSize, n - i);
+         for (Int_t j = 0; j < fNdim; j++) {
+            // pad the last vector by repeating the last point
+            xvec[j] = ROOT::Double_v(x[j * n + n - 1]);
+            for (Int_t k = 0; k < nInVec; k++)
+               vecCore::Set(xvec[j], k, x[j * n + i + k]);
+         }
+         ROOT::Double_v ans = fcn(xvec.data(), (Double_t *)params);
+         for (Int_t k = 0; k < nInVec; k++)
+            result[i + k] = vecCore::Get(ans, k);
+      }
+   }
+#endif
+   else {
+      // EvalPar takes care of the normalization
+      std::vector<Double_t> xx(fNdim);
+      for (Int_t i = 0; i < n; i++) {
+         for (Int_t j = 0; j < fNdim; j++)
+            xx[j] = x[j * n + i];
+         if (fType == EFType::kInterpreted)
+            InitArgs(xx.data(), params);
+         result[i] = EvalPar(xx.data(), params);
+      }
+      return;
+   }
+
+   if (fNormalized && fNormIntegral != 0) {
+      for (Int_t i = 0; i < n; i++)
+         result[i] /= fNormIntegral;
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Execute action corresponding to one event.
 ///
@@ -2656,13 +2717,24 @@ Double_t TF1::IntegralFast(Int_t num, Double_t * /* x */, Double_t * /* w */, Do
 {
    // Now x and w are not used!
 
-   ROOT::Math::WrappedTF1 wf1(*this);
-   if (params)
-      wf1.SetParameters(params);
    ROOT::Math::GaussLegendreIntegrator gli(num, epsilon);
-   gli.SetFunction(wf1);
-   return gli.Integral(a, b);
+   if (num <= 0)
+      return 0;
+
+   // evaluate all sampling points in one go, see EvalN; any further
+   // coordinates of a multi-dimensional function are left at 0
+   std::vector<Double_t> xx(num * TMath::Max(fNdim, 1)), ww(num), fx(num);
+   gli.GetWeightVectors(xx.data(), ww.data());
+   const Double_t a0 = (b + a) / 2;
+   const Double_t b0 = (b - a) / 2;
+   for (Int_t i = 0; i < num; i++)
+      xx[i] = a0 + b0 * xx[i];
+   EvalN(num, xx.data(), fx.data(), params);
 
+   Double_t result = 0;
+   for (Int_t i = 0; i < num; i++)
+      result += ww[i] * fx[i];
+   return result * b0;
 }
 
 
@@ -3119,6 +3119,52 @@ Double_t TFormula::EvalPar(const Double_t *x,const Double_t *params) const
 #endif
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluate the formula at n points and store the values in result[0..n-1].
+/// The coordinates are given per variable: x[j * n + i] is variable j of
+/// point i, i.e. the values of each variable are contiguous.
+/// If the formula is vectorized (see SetVectorized()) the points are
+/// evaluated in chunks of the SIMD vector size, loading each variable
+/// directly from x; otherwise they are evaluated one by one.
+
+void TFormula::EvalN(Int_t n, const Double_t *x, Double_t *result, const Double_t *params) const
+{
+   if (n <= 0)
+      return;
+
+#ifdef R__HAS_VECCORE
+   if (fVectorized) {
+      const Int_t vecSize = vecCore::VectorSize<ROOT::Double_v>();
+      std::vector<ROOT::Double_v> xvec(fNdim);
+      Int_t i = 0;
+      for (; i + vecSize <= n; i += vecSize) {
+         for (Int_t j = 0; j < fNdim; j++)
+            vecCore::Load<ROOT::Double_v>(xvec[j], x + j * n + i);
+         vecCore::Store<ROOT::Double_v>(DoEvalVec(xvec.data(), params), result + i);
+      }
+      if (i < n) {
+         // remaining points: pad the last vector by repeating the last point
+         for (Int_t j = 0; j < fNdim; j++) {
+            xvec[j] = ROOT::Double_v(x[j * n + n - 1]);
+            for (Int_t k = 0; k < n - i; k++)
+               vecCore::Set(xvec[j], k, x[j * n + i + k]);
+         }
+         ROOT::Double_v ans = DoEvalVec(xvec.data(), params);
+         for (Int_t k = 0; k < n - i; k++)
+            result[i + k] = vecCore::Get(ans, k);
+      }
+      return;
+   }
+#endif
+
+   std::vector<Double_t> xx(fNdim);
+   for (Int_t i = 0; i < n; i++) {
+      for (Int_t j = 0; j < fNdim; j++)
+         xx[j] = x[j * n + i];
+      result[i] = EvalPar(xx.data(), params);
+   }
+}
+
 bool TFormula::fIsCladRuntimeIncluded = false;
 
 static bool functionExists(const string &Name) {
@@ -552,6 +552,51 @@ void TH2::FillN(Int_t ntimes, const Double_t *x, const Double_t *y, const Double
    }
 
    Double_t ww = 1;
+
+   // if none of the axes can be extended, compute the bin numbers of a chunk of
+   // entries at once and accumulate the statistics in local variables
+   if (!(fXaxis.CanExtend() && !fXaxis.IsAlphanumeric()) && !(fYaxis.CanExtend() && !fYaxis.IsAlphanumeric())) {
+      const Int_t kChunk = 256;
+      Int_t binsx[kChunk], binsy[kChunk];
+      const Int_t nbinsx = fXaxis.GetNbins(), nbinsy = fYaxis.GetNbins();
+      const Bool_t statOverflows = GetStatOverflowsBehaviour();
+      Double_t tsumw = fTsumw, tsumw2 = fTsumw2, tsumwx = fTsumwx, tsumwx2 = fTsumwx2;
+      Double_t tsumwy = fTsumwy, tsumwy2 = fTsumwy2, tsumwxy = fTsumwxy;
+      for (Int_t i0 = ifirst; i0 < ntimes; i0 += kChunk*stride) {
+         const Int_t n = TMath::Min(kChunk, (ntimes - i0 + stride - 1)/stride);
+         fXaxis.FindFixBins(n, x + i0, binsx, stride);
+         fYaxis.FindFixBins(n, y + i0, binsy, stride);
+         fEntries += n;
+         for (Int_t j = 0; j < n; ++j) {
+            i = i0 + j*stride;
+            binx = binsx[j];
+            biny = binsy[j];
+            bin  = biny*(nbinsx+2) + binx;
+            if (w) ww = w[i];
+            if (!fSumw2.fN && ww != 1.0 && !TestBit(TH1::kIsNotW))  Sumw2();
+            if (fSumw2.fN) fSumw2.fArray[bin] += ww*ww;
+            AddBinContent(bin,ww);
+            if (binx == 0 || binx > nbinsx) {
+               if (!statOverflows) continue;
+            }
+            if (biny == 0 || biny > nbinsy) {
+               if (!statOverflows) continue;
+            }
+            Double_t z= ww;
+            tsumw   += z;
+            tsumw2  += z*z;
+            tsumwx  += z*x[i];
+            tsumwx2 += z*x[i]*x[i];
+            tsumwy  += z*y[i];
+            tsumwy2 += z*y[i]*y[i];
+            tsumwxy += z*x[i]*y[i];
+         }
+      }
+      fTsumw = tsumw; fTsumw2 = tsumw2; fTsumwx = tsumwx; fTsumwx2 = tsumwx2;
+      fTsumwy = tsumwy; fTsumwy2 = tsumwy2; fTsumwxy = tsumwxy;
+      return;
+   }
+
    for (i=ifirst;i<ntimes;i+=stride) {
       fEntries++;
       binx = fXaxis.FindBin(x[i]);
@@ -324,6 +324,23 @@ THnBase* THnBase::CreateHnAny(const char* name, const char* title,
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Fill nEntries entries in one go. x holds the coordinates of the entries one
+/// after the other, i.e. x[i * GetNdimensions() + d] is the coordinate of entry
+/// i along dimension d. w holds the weights of the entries; if it is 0, all
+/// entries get a weight of 1.
+
+void THnBase::FillN(Long64_t nEntries, const Double_t *x, const Double_t *w /*= 0*/)
+{
+   const Int_t ndim = GetNdimensions();
+   for (Long64_t i = 0; i < nEntries; ++i, x += ndim) {
+      const Double_t weight = w ? w[i] : 1.;
+      UpdateXStat(x, weight);
+      FillBin(GetBin(x, kTRUE /*alloc*/), weight);
+   }
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Fill the THnBase with the bins of hist that have content
 /// or error != 0.
@@ -521,6 +538,15 @@ TObject* THnBase::ProjectionAny(Int_t ndim, const Int_t* dim,
    Bool_t haveErrors = GetCalculateErrors();
    Bool_t wantErrors = haveErrors || (option && (strchr(option, 'E') || strchr(option, 'e')));
 
+   // Accumulate the squared errors directly in the target histogram's
+   // sum of squares of weights instead of going through Get/SetBinError,
+   // which would cost two square roots per projected bin.
+   Double_t* histSumw2 = 0;
+   if (!wantNDim && wantErrors) {
+      if (!hist->GetSumw2N()) hist->Sumw2();
+      histSumw2 = hist->GetSumw2()->GetArray();
+   }
+
    Int_t* bins  = new Int_t[ndim];
    Long64_t myLinBin = 0;
 
@@ -558,8 +584,7 @@ TObject* THnBase::ProjectionAny(Int_t ndim, const Int_t* dim,
          if (wantNDim) {
             hn->AddBinError2(targetLinBin, err2);
          } else {
-            Double_t preverr = hist->GetBinError(targetLinBin);
-            hist->SetBinError(targetLinBin, TMath::Sqrt(preverr * preverr + err2));
+            histSumw2[targetLinBin] += err2;
          }
       }
 
@@ -793,7 +793,13 @@ Long64_t THnSparse::GetBinIndexForCurrentBin(Bool_t allocate)
    ULong64_t hash = cc->GetHash();
    if (fBinContent.GetSize() && !fBins.GetSize())
       FillExMap();
-   Long64_t linidx = (Long64_t) fBins.GetValue(hash);
+   UInt_t slot = 0;
+   Long64_t linidx = (Long64_t) fBins.GetValue(hash, hash, slot);
+   if (linidx && cc->GetBufferSize() <= 8) {
+      // The hash is the compact coordinate itself ("perfect hash"), so the
+      // entry found is the right one; don't touch the chunk's coordinates.
+      return linidx - 1;
+   }
    while (linidx) {
       // fBins stores index + 1!
       THnSparseArrayChunk* chunk = GetChunk((linidx - 1)/ fChunkSize);
@@ -821,10 +827,14 @@ Long64_t THnSparse::GetBinIndexForCurrentBin(Bool_t allocate)
    // store translation between hash and bin
    newidx += (fBinContent.GetEntriesFast() - 1) * fChunkSize;
    if (!linidx) {
-      // fBins didn't find it
-      if (2 * GetNbins() > fBins.Capacity())
+      // fBins didn't find it; re-use the slot found by the lookup
+      // unless the table needs to grow.
+      if (2 * GetNbins() > fBins.Capacity()) {
          fBins.Expand(3 * GetNbins());
-      fBins.Add(hash, newidx + 1);
+         fBins.Add(hash, newidx + 1);
+      } else {
+         fBins.AddAt(slot, hash, hash, newidx + 1);
+      }
    } else {
       // fBins contains one, but it's the wrong one;
       // add entry to fBinsContinued.
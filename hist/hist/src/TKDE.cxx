@@ -43,6 +43,11 @@
 #include "TCanvas.h"
 #include "TKDE.h"
 
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#include "TROOT.h"
+#endif
+
 
 ClassImp(TKDE);
 
@@ -50,6 +55,12 @@ class TKDE::TKernel {
    TKDE* fKDE;
    UInt_t fNWeights; // Number of kernel weights (bandwidth as vectorized for binning)
    std::vector<Double_t> fWeights; // Kernel weights (bandwidth)
+   Double_t fSupport; // Kernel support in units of the bandwidth, 0 if unbounded
+   Double_t fMaxWeight; // Largest kernel weight
+   std::vector<UInt_t> fSortedIndex; // Indices of the data sorted by value
+   std::vector<Double_t> fSortedData; // Data sorted by value
+   void SetSortedData();
+   Double_t SumInRange(Double_t x, Double_t offset, Double_t sign) const;
 public:
    TKernel(Double_t weight, TKDE* kde);
    void ComputeAdaptiveWeights();
@@ -696,8 +707,40 @@ TKDE::TKernel::TKernel(Double_t weight, TKDE* kde) :
 // Internal class constructor
 fKDE(kde),
 fNWeights(kde->fData.size()),
-fWeights(fNWeights, weight)
-{}
+fWeights(fNWeights, weight),
+fSupport(0.0),
+fMaxWeight(weight)
+{
+   // The built-in kernels vanish outside a known range (see TKDE::GaussianKernel),
+   // so only the data within that range around x contribute to the estimate
+   switch (kde->fKernelType) {
+      case kGaussian :
+         fSupport = 9.;
+         break;
+      case kEpanechnikov :
+      case kBiweight :
+      case kCosineArch :
+         fSupport = 1.;
+         break;
+      default:
+         fSupport = 0.;
+   }
+   SetSortedData();
+}
+
+void TKDE::TKernel::SetSortedData() {
+   // Sorts the data for the truncated kernel sum in operator()
+   fSortedIndex.clear();
+   fSortedData.clear();
+   if (fSupport <= 0) return;
+   const std::vector<Double_t> & data = fKDE->fData;
+   fSortedIndex.resize(data.size());
+   std::iota(fSortedIndex.begin(), fSortedIndex.end(), 0);
+   std::sort(fSortedIndex.begin(), fSortedIndex.end(), [&data](UInt_t a, UInt_t b) { return data[a] < data[b]; });
+   fSortedData.resize(data.size());
+   for (UInt_t i = 0; i < data.size(); ++i)
+      fSortedData[i] = data[fSortedIndex[i]];
+}
 
 void TKDE::TKernel::ComputeAdaptiveWeights() {
    // Gets the adaptive weights (bandwidths) for TKernel internal computation
@@ -706,11 +749,29 @@ void TKDE::TKernel::ComputeAdaptiveWeights() {
    unsigned int n = fKDE->fData.size();
    assert( n == weights.size() );
    bool useDataWeights = (fKDE->fBinCount.size() == n); 
+
+   // The fixed-bandwidth estimate at each data point is independent of the
+   // others: compute them first, in parallel if implicit multi-threading is
+   // enabled and the kernel is a built-in (hence thread-safe) one
+   std::vector<Double_t> fValues(n, 0.0);
+   auto evalAtData = [&](UInt_t i) {
+      if (useDataWeights && fKDE->fBinCount[i] <= 0) return;
+      fValues[i] = (*this)(fKDE->fData[i]);
+   };
+#ifdef R__USE_IMT
+   if (ROOT::IsImplicitMTEnabled() && fKDE->fKernelType != kUserDefined) {
+      ROOT::TThreadExecutor pool;
+      pool.Foreach(evalAtData, ROOT::TSeq<UInt_t>(0, n));
+   } else
+#endif
+   for (UInt_t i = 0; i < n; ++i)
+      evalAtData(i);
+
    Double_t f = 0.0;
    for (unsigned int i = 0; i < n; ++i) { 
 //   for (; weight != weights.end(); ++weight, ++data, ++dataW) {
       if (useDataWeights && fKDE->fBinCount[i] <= 0) continue;  // skip negative or null weights
-      f = (*fKDE->fKernel)(fKDE->fData[i]);
+      f = fValues[i];
       if (f <= 0)
          fKDE->Warning("ComputeAdativeWeights","function value is zero or negative for x = %f w = %f",
                        fKDE->fData[i],(useDataWeights) ? fKDE->fBinCount[i] : 1.);
@@ -722,6 +783,7 @@ void TKDE::TKernel::ComputeAdaptiveWeights() {
    fKDE->fAdaptiveBandwidthFactor = fKDE->fUseMirroring ? kAPPROX_GEO_MEAN / fKDE->fSigmaRob : std::sqrt(std::exp(fKDE->fAdaptiveBandwidthFactor / fKDE->fData.size()));
    transform(weights.begin(), weights.end(), fWeights.begin(),
              std::bind(std::multiplies<Double_t>(), std::placeholders::_1, fKDE->fAdaptiveBandwidthFactor));
+   fMaxWeight = *std::max_element(fWeights.begin(), fWeights.end());
    //printf("adaptive bandwidth factor % f weight 0 %f , %f \n",fKDE->fAdaptiveBandwidthFactor, weights[0],fWeights[0] );
 }
 
@@ -905,6 +967,23 @@ const std::vector<Double_t> & TKDE::TKernel::GetAdaptiveWeights() const {
    return fWeights;
 }
 
+Double_t TKDE::TKernel::SumInRange(Double_t x, Double_t offset, Double_t sign) const {
+   // Returns the kernel sum at x over the data points d mapped to offset + sign * d
+   // (sign is +1 or -1), visiting only the points within the kernel support
+   const Double_t halfWidth = fSupport * fMaxWeight;
+   const Double_t centre = sign * (x - offset);
+   std::vector<Double_t>::const_iterator first = std::lower_bound(fSortedData.begin(), fSortedData.end(), centre - halfWidth);
+   std::vector<Double_t>::const_iterator last = std::upper_bound(first, fSortedData.end(), centre + halfWidth);
+   Bool_t useBins = (fKDE->fBinCount.size() == fKDE->fData.size());
+   Double_t result(0.0);
+   for (UInt_t j = first - fSortedData.begin(); j < UInt_t(last - fSortedData.begin()); ++j) {
+      UInt_t i = fSortedIndex[j];
+      Double_t binCount = (useBins) ? fKDE->fBinCount[i] : 1.0;
+      result += binCount / fWeights[i] * (*fKDE->fKernelFunction)((x - (offset + sign * fSortedData[j])) / fWeights[i]);
+   }
+   return result;
+}
+
 Double_t TKDE::TKernel::operator()(Double_t x) const {
    // The internal class's unary function: returns the kernel density estimate
    Double_t result(0.0);
@@ -912,6 +991,18 @@ Double_t TKDE::TKernel::operator()(Double_t x) const {
    // case of bins or weighted data 
    Bool_t useBins = (fKDE->fBinCount.size() == n);
    Double_t nSum = (useBins) ? fKDE->fSumOfCounts : fKDE->fNEvents;
+   if (fSupport > 0 && fSortedData.size() == n) {
+      // truncated kernel: only sum over the data close to x
+      result = SumInRange(x, 0., 1.);
+      if (fKDE->fAsymLeft)
+         result -= SumInRange(x, 2. * fKDE->fXMin, -1.);
+      if (fKDE->fAsymRight)
+         result -= SumInRange(x, 2. * fKDE->fXMax, -1.);
+      if ( TMath::IsNaN(result) ) {
+         fKDE->Warning("operator()","Result is NaN for  x %f \n",x);
+      }
+      return result / nSum;
+   }
    // double dmin = 1.E10;
    // double xmin,bmin,wmin; 
    for (UInt_t i = 0; i < n; ++i) {
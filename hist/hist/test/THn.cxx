@@ -1,9 +1,12 @@
 #include "gtest/gtest.h"
 
 #include "THn.h"
+#include "THnSparse.h"
 #include "TH1.h"
 #include "TH2.h"
 
+#include <vector>
+
 // Filling THn
 TEST(THn, Fill) {
    Int_t bins[2] = {2, 3};
@@ -108,3 +111,46 @@ TEST(THn, Projection) {
 
 
 }
+
+// Batch filling of THnSparse and projecting with errors
+TEST(THnSparse, FillNProjection) {
+   Int_t bins[2] = {10, 20};
+   Double_t xmin[2] = {0., -1.};
+   Double_t xmax[2] = {10., 1.};
+   THnSparseD hn("hn", "hn", 2, bins, xmin, xmax);
+   THnSparseD hnRef("hnRef", "hnRef", 2, bins, xmin, xmax);
+   hn.Sumw2();
+   hnRef.Sumw2();
+
+   const Long64_t n = 100;
+   std::vector<Double_t> x(2 * n);
+   std::vector<Double_t> w(n);
+   for (Long64_t i = 0; i < n; ++i) {
+      x[2 * i] = (i % 12) - 0.5;
+      x[2 * i + 1] = 0.03 * (i % 70) - 1.05;
+      w[i] = 0.1 * (i % 5) + 0.5;
+      hnRef.Fill(&x[2 * i], w[i]);
+   }
+   hn.FillN(n, x.data(), w.data());
+
+   EXPECT_EQ(hnRef.GetNbins(), hn.GetNbins());
+   EXPECT_DOUBLE_EQ(hnRef.GetEntries(), hn.GetEntries());
+   Int_t coord[2];
+   for (Long64_t i = 0; i < hnRef.GetNbins(); ++i) {
+      Double_t v = hnRef.GetBinContent(i, coord);
+      Long64_t bin = hn.GetBin(coord, kFALSE);
+      ASSERT_GE(bin, 0);
+      EXPECT_DOUBLE_EQ(v, hn.GetBinContent(bin));
+      EXPECT_DOUBLE_EQ(hnRef.GetBinError2(i), hn.GetBinError2(bin));
+   }
+
+   TH1D* hProj = hn.Projection(1);
+   Double_t sumErr2 = 0.;
+   for (Int_t i = 0; i <= hProj->GetNbinsX() + 1; ++i)
+      sumErr2 += hProj->GetBinError(i) * hProj->GetBinError(i);
+   Double_t sumw2 = 0.;
+   for (Long64_t i = 0; i < n; ++i)
+      sumw2 += w[i] * w[i];
+   EXPECT_NEAR(sumw2, sumErr2, 1e-12);
+   delete hProj;
+}
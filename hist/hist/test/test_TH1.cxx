@@ -2,6 +2,13 @@
 
 #include "TH1.h"
 #include "TH1F.h"
+#include "TH1D.h"
+#include "TH2.h"
+#include "TH3.h"
+#include "ROOT/TH1ConcurrentFill.hxx"
+
+#include <thread>
+#include <vector>
 
 // StatOverflows TH1
 TEST(TH1, StatOverflows)
@@ -30,3 +37,176 @@ TEST(TH1, StatOverflows)
    EXPECT_EQ(TH1::EStatOverflows::kConsider, h1.GetStatOverflows());
    EXPECT_EQ(TH1::EStatOverflows::kNeutral,  h2.GetStatOverflows());
 }
+
+// FillN gives the same result as filling entry by entry
+TEST(TH1, FillN)
+{
+   const Int_t n = 1000;
+   std::vector<Double_t> x(n), w(n);
+   for (Int_t i = 0; i < n; ++i) {
+      x[i] = -0.5 + 2. * i / n;
+      w[i] = 0.5 + (i % 7);
+   }
+
+   TH1D h0("h0", "h0", 17, 0, 1);
+   TH1D h1("h1", "h1", 17, 0, 1);
+   for (Int_t i = 0; i < n; ++i)
+      h0.Fill(x[i], w[i]);
+   h1.FillN(n, x.data(), w.data());
+
+   EXPECT_EQ(h0.GetEntries(), h1.GetEntries());
+   for (Int_t bin = 0; bin <= h0.GetNbinsX() + 1; ++bin) {
+      EXPECT_EQ(h0.GetBinContent(bin), h1.GetBinContent(bin));
+      EXPECT_EQ(h0.GetBinError(bin), h1.GetBinError(bin));
+   }
+   Double_t s0[4], s1[4];
+   h0.GetStats(s0);
+   h1.GetStats(s1);
+   for (Int_t i = 0; i < 4; ++i)
+      EXPECT_DOUBLE_EQ(s0[i], s1[i]);
+}
+
+// TH2::FillN gives the same contents, errors and statistics as filling entry by entry,
+// including entries in the under- and overflow bins
+static void CheckTH2FillN(TH1::EStatOverflows statOverflows)
+{
+   const Int_t n = 1000;
+   std::vector<Double_t> x(n), y(n), w(n);
+   for (Int_t i = 0; i < n; ++i) {
+      x[i] = -0.5 + 2. * i / n;
+      y[i] = 1.3 - 1.7 * ((i * 37) % n) / n;
+      w[i] = 0.5 + (i % 7);
+   }
+
+   TH2D h0("h0", "h0", 7, 0, 1, 5, 0, 1);
+   TH2D h1("h1", "h1", 7, 0, 1, 5, 0, 1);
+   h0.SetStatOverflows(statOverflows);
+   h1.SetStatOverflows(statOverflows);
+   for (Int_t i = 0; i < n; ++i)
+      h0.Fill(x[i], y[i], w[i]);
+   h1.FillN(n, x.data(), y.data(), w.data());
+
+   EXPECT_EQ(h0.GetEntries(), h1.GetEntries());
+   ASSERT_EQ(h0.GetSumw2N(), h1.GetSumw2N());
+   for (Int_t bin = 0; bin < h0.GetNcells(); ++bin) {
+      EXPECT_EQ(h0.GetBinContent(bin), h1.GetBinContent(bin)) << "bin " << bin;
+      EXPECT_EQ(h0.GetSumw2()->At(bin), h1.GetSumw2()->At(bin)) << "bin " << bin;
+   }
+   EXPECT_GT(h0.GetBinContent(0, 0), 0.);
+   EXPECT_GT(h0.GetBinContent(8, 6), 0.);
+
+   Double_t s0[7], s1[7];
+   h0.GetStats(s0);
+   h1.GetStats(s1);
+   for (Int_t i = 0; i < 7; ++i)
+      EXPECT_DOUBLE_EQ(s0[i], s1[i]) << "moment " << i;
+}
+
+TEST(TH2, FillN)
+{
+   CheckTH2FillN(TH1::EStatOverflows::kIgnore);
+   CheckTH2FillN(TH1::EStatOverflows::kConsider);
+}
+
+// Fill a histogram from several threads through a TH1ConcurrentFillManager
+template <class FILL>
+static void ConcurrentFill(TH1 &h, Int_t nThreads, FILL fill)
+{
+   ROOT::TH1ConcurrentFillManager<128> manager(h);
+   std::vector<std::thread> threads;
+   for (Int_t t = 0; t < nThreads; ++t) {
+      threads.emplace_back([&manager, &fill]() {
+         auto filler = manager.MakeFiller();
+         fill(filler);
+      });
+   }
+   for (auto &thread : threads)
+      thread.join();
+}
+
+static void ExpectEqualHists(const TH1 &h0, const TH1 &h1)
+{
+   EXPECT_EQ(h0.GetEntries(), h1.GetEntries());
+   for (Int_t bin = 0; bin < h0.GetNcells(); ++bin) {
+      EXPECT_EQ(h0.GetBinContent(bin), h1.GetBinContent(bin)) << "bin " << bin;
+      EXPECT_EQ(h0.GetBinError(bin), h1.GetBinError(bin)) << "bin " << bin;
+   }
+}
+
+// Concurrent filling of a shared histogram gives the same contents as serial filling
+TEST(TH1, ConcurrentFill)
+{
+   const Int_t nThreads = 4;
+   const Int_t n = 10000;
+   TH2D h0("h0", "h0", 10, 0, 1, 10, 0, 1);
+   TH2D h1("h1", "h1", 10, 0, 1, 10, 0, 1);
+   h0.Sumw2();
+   h1.Sumw2();
+   for (Int_t t = 0; t < nThreads; ++t) {
+      for (Int_t i = 0; i < n; ++i) {
+         h0.Fill((i % 97) / 97., (i % 89) / 89., 0.5);
+         h0.Fill((i % 83) / 83., (i % 79) / 79.);
+      }
+   }
+
+   ConcurrentFill(h1, nThreads, [](ROOT::TH1ConcurrentFiller<128> &filler) {
+      for (Int_t i = 0; i < n; ++i) {
+         filler.Fill((i % 97) / 97., (i % 89) / 89., 0.5);
+         filler.Fill((i % 83) / 83., (i % 79) / 79.);
+      }
+   });
+
+   ExpectEqualHists(h0, h1);
+}
+
+// Fill(x) and Fill(x, w) of a 1D histogram
+TEST(TH1, ConcurrentFill1D)
+{
+   const Int_t nThreads = 4;
+   const Int_t n = 10000;
+   TH1D h0("h0", "h0", 20, 0, 1);
+   TH1D h1("h1", "h1", 20, 0, 1);
+   h0.Sumw2();
+   h1.Sumw2();
+   for (Int_t t = 0; t < nThreads; ++t) {
+      for (Int_t i = 0; i < n; ++i) {
+         h0.Fill((i % 97) / 97.);
+         h0.Fill((i % 89) / 89., 2.5);
+      }
+   }
+
+   ConcurrentFill(h1, nThreads, [](ROOT::TH1ConcurrentFiller<128> &filler) {
+      for (Int_t i = 0; i < n; ++i) {
+         filler.Fill((i % 97) / 97.);
+         filler.Fill((i % 89) / 89., 2.5);
+      }
+   });
+
+   ExpectEqualHists(h0, h1);
+}
+
+// Fill(x, y, z) and Fill(x, y, z, w) of a 3D histogram
+TEST(TH1, ConcurrentFill3D)
+{
+   const Int_t nThreads = 4;
+   const Int_t n = 10000;
+   TH3D h0("h0", "h0", 5, 0, 1, 5, 0, 1, 5, 0, 1);
+   TH3D h1("h1", "h1", 5, 0, 1, 5, 0, 1, 5, 0, 1);
+   h0.Sumw2();
+   h1.Sumw2();
+   for (Int_t t = 0; t < nThreads; ++t) {
+      for (Int_t i = 0; i < n; ++i) {
+         h0.Fill((i % 97) / 97., (i % 89) / 89., (i % 83) / 83.);
+         h0.Fill((i % 79) / 79., (i % 73) / 73., (i % 71) / 71., 0.5);
+      }
+   }
+
+   ConcurrentFill(h1, nThreads, [](ROOT::TH1ConcurrentFiller<128> &filler) {
+      for (Int_t i = 0; i < n; ++i) {
+         filler.Fill((i % 97) / 97., (i % 89) / 89., (i % 83) / 83.);
+         filler.Fill((i % 79) / 79., (i % 73) / 73., (i % 71) / 71., 0.5);
+      }
+   });
+
+   ExpectEqualHists(h0, h1);
+}
@@ -0,0 +1,171 @@
+#include "TKDE.h"
+#include "TRandom3.h"
+#include "TROOT.h"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+// Reference kernel density estimate summing over all events
+static double bruteForceKDE(double x, const std::vector<double> &data, const double *weights, bool gaussian)
+{
+   double result = 0.;
+   for (unsigned int i = 0; i < data.size(); ++i) {
+      double u = (x - data[i]) / weights[i];
+      double k = 0.;
+      if (gaussian)
+         k = (u > -9. && u < 9.) ? std::exp(-0.5 * u * u) / std::sqrt(2. * M_PI) : 0.;
+      else
+         k = (u > -1. && u < 1.) ? 0.75 * (1. - u * u) : 0.;
+      result += k / weights[i];
+   }
+   return result / data.size();
+}
+
+TEST(TKDE, TruncatedKernelSum)
+{
+   TRandom3 rndm(1234);
+   const unsigned int n = 2000;
+   std::vector<double> data(n);
+   for (auto &x : data)
+      x = rndm.Gaus(0., 1.);
+
+   TKDE kdeFixed(n, data.data(), -5., 5., "KernelType:Epanechnikov;Iteration:Fixed;Mirror:noMirror;Binning:Unbinned");
+   std::vector<double> fixedWeights(n, kdeFixed.GetFixedWeight());
+
+   TKDE kdeAdaptive(n, data.data(), -5., 5., "KernelType:Gaussian;Iteration:Adaptive;Mirror:noMirror;Binning:Unbinned");
+   const double *adaptiveWeights = kdeAdaptive.GetAdaptiveWeights();
+
+   for (double x = -4.; x < 4.; x += 0.37) {
+      EXPECT_NEAR(bruteForceKDE(x, data, fixedWeights.data(), false), kdeFixed(x), 1e-12);
+      EXPECT_NEAR(bruteForceKDE(x, data, adaptiveWeights, true), kdeAdaptive(x), 1e-12);
+   }
+}
+
+// Reference estimate summing over all points, with weights (counts) and the bandwidth of each point,
+// and subtracting the points reflected at each edge in asymEdges
+static double fullKDE(double x, const std::vector<double> &points, const std::vector<double> &counts,
+                      const double *weights, const std::vector<double> &asymEdges, double norm)
+{
+   double result = 0.;
+   for (unsigned int i = 0; i < points.size(); ++i) {
+      const double count = counts.empty() ? 1. : counts[i];
+      std::vector<double> centre(1, points[i]);
+      double k = bruteForceKDE(x, centre, weights + i, true);
+      for (double edge : asymEdges) {
+         centre[0] = 2. * edge - points[i];
+         k -= bruteForceKDE(x, centre, weights + i, true);
+      }
+      result += count * k;
+   }
+   return result / norm;
+}
+
+TEST(TKDE, TruncatedKernelSumMirrored)
+{
+   TRandom3 rndm(4321);
+   const unsigned int n = 1000;
+   const double xMin = -2., xMax = 2.;
+   std::vector<double> data;
+   while (data.size() < n) {
+      const double x = rndm.Gaus(0., 1.);
+      if (x > xMin && x < xMax)
+         data.push_back(x);
+   }
+
+   // Reflected terms subtracted at both edges
+   TKDE kdeAsym(n, data.data(), xMin, xMax, "KernelType:Gaussian;Iteration:Fixed;Mirror:MirrorAsymBoth;Binning:Unbinned");
+   std::vector<double> asymWeights(n, kdeAsym.GetFixedWeight());
+
+   // Data mirrored at the left edge, reflected terms subtracted at the right edge
+   TKDE kdeMixed(n, data.data(), xMin, xMax, "KernelType:Gaussian;Iteration:Fixed;Mirror:MirrorLeftAsymRight;Binning:Unbinned");
+   std::vector<double> mirrored = data;
+   for (double x : data)
+      mirrored.push_back(2. * xMin - x);
+   std::vector<double> mixedWeights(mirrored.size(), kdeMixed.GetFixedWeight());
+
+   for (double x = xMin; x <= xMax; x += 0.13) {
+      EXPECT_NEAR(fullKDE(x, data, {}, asymWeights.data(), {xMin, xMax}, n), kdeAsym(x), 1e-12);
+      EXPECT_NEAR(fullKDE(x, mirrored, {}, mixedWeights.data(), {xMax}, n), kdeMixed(x), 1e-12);
+   }
+}
+
+TEST(TKDE, TruncatedKernelSumBinned)
+{
+   TRandom3 rndm(5678);
+   const unsigned int n = 2000;
+   const unsigned int nBins = 100; // default number of bins for fewer than 10000 events
+   const double xMin = -5., xMax = 5.;
+   std::vector<double> data(n);
+   for (auto &x : data)
+      x = rndm.Gaus(0., 1.);
+
+   // Bin centres and counts as used in the binned mode
+   const double binWidth = (xMax - xMin) / nBins;
+   const double weightSize = nBins / (xMax - xMin);
+   std::vector<double> centres(nBins), counts(nBins, 0.);
+   for (unsigned int i = 0; i < nBins; ++i)
+      centres[i] = xMin + (i + 0.5) * binWidth;
+   double sumOfCounts = 0.;
+   for (double x : data) {
+      if (x < xMin || x >= xMax)
+         continue;
+      int bin = int((x - xMin) * weightSize);
+      if (bin == int(nBins))
+         --bin;
+      counts[bin] += 1.;
+      sumOfCounts += 1.;
+   }
+
+   TKDE kdeFixed(n, data.data(), xMin, xMax, "KernelType:Gaussian;Iteration:Fixed;Mirror:noMirror;Binning:ForcedBinning");
+   std::vector<double> fixedWeights(nBins, kdeFixed.GetFixedWeight());
+
+   TKDE kdeAdaptive(n, data.data(), xMin, xMax, "KernelType:Gaussian;Iteration:Adaptive;Mirror:noMirror;Binning:ForcedBinning");
+   const double *adaptiveWeights = kdeAdaptive.GetAdaptiveWeights();
+
+   for (double x = -4.; x < 4.; x += 0.37) {
+      EXPECT_NEAR(fullKDE(x, centres, counts, fixedWeights.data(), {}, sumOfCounts), kdeFixed(x), 1e-12);
+      EXPECT_NEAR(fullKDE(x, centres, counts, adaptiveWeights, {}, sumOfCounts), kdeAdaptive(x), 1e-12);
+   }
+}
+
+#ifdef R__USE_IMT
+// The adaptive bandwidths computed with implicit multi-threading equal those computed from the full
+// fixed-bandwidth estimate at each data point
+TEST(TKDE, AdaptiveWeightsImplicitMT)
+{
+   TRandom3 rndm(8765);
+   const unsigned int n = 2000;
+   std::vector<double> data(n);
+   for (auto &x : data)
+      x = rndm.Gaus(0., 1.);
+
+   TKDE kdeFixed(n, data.data(), -5., 5., "KernelType:Gaussian;Iteration:Fixed;Mirror:noMirror;Binning:Unbinned");
+   const double fixedWeight = kdeFixed.GetFixedWeight();
+
+   ROOT::EnableImplicitMT(4);
+   TKDE kdeAdaptive(n, data.data(), -5., 5., "KernelType:Gaussian;Iteration:Adaptive;Mirror:noMirror;Binning:Unbinned");
+   ROOT::DisableImplicitMT();
+   const double *adaptiveWeights = kdeAdaptive.GetAdaptiveWeights();
+
+   // Adaptive bandwidths from the pilot estimate, as in TKDE::TKernel::ComputeAdaptiveWeights
+   std::vector<double> fixedWeights(n, fixedWeight);
+   std::vector<double> weights(n);
+   double logSum = 1.; // the sum starts from the initial bandwidth factor of TKDE
+   for (unsigned int i = 0; i < n; ++i) {
+      const double f = fullKDE(data[i], data, {}, fixedWeights.data(), {}, n);
+      weights[i] = std::max(fixedWeight / std::sqrt(f), 0.05 * fixedWeight);
+      logSum += std::log(f);
+   }
+   const double factor = std::sqrt(std::exp(logSum / n));
+   for (unsigned int i = 0; i < n; ++i) {
+      weights[i] *= factor;
+      EXPECT_NEAR(weights[i], adaptiveWeights[i], 1e-12 * weights[i]) << "event " << i;
+   }
+
+   for (double x = -4.; x < 4.; x += 0.37)
+      EXPECT_NEAR(fullKDE(x, data, {}, weights.data(), {}, n), kdeAdaptive(x), 1e-12);
+}
+#endif
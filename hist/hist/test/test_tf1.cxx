@@ -1,4 +1,6 @@
 #include "TF1.h"
+#include "TF12.h"
+#include "TF2.h"
 #include "TF1NormSum.h"
 #include "TObjString.h"
 
@@ -219,3 +221,45 @@ TEST(TF1, Constructors)
    for (auto tf1 : vtf1)
       EXPECT_EQ(tf1(&x, &p), 2);
 }
+
+TEST(TF1, EvalN)
+{
+   TF1 f1("f1", "[0]*exp(-0.5*((x-[1])/[2])^2)", -5, 5);
+   f1.SetParameters(2., 0.5, 1.5);
+   TF1 f2("f2", "x*[0] + y*y", -5, 5);
+   f2.SetParameter(0, 3.);
+
+   const Int_t n = 13; // not a multiple of the SIMD vector size
+   double x[2 * n];
+   double r1[n], r2[n];
+   for (Int_t i = 0; i < n; ++i) {
+      x[i] = -4. + 0.6 * i;
+      x[n + i] = 2. - 0.3 * i;
+   }
+   f1.EvalN(n, x, r1);
+   f2.EvalN(n, x, r2);
+   for (Int_t i = 0; i < n; ++i) {
+      EXPECT_NEAR(f1.Eval(x[i]), r1[i], delta);
+      EXPECT_NEAR(f2.Eval(x[i], x[n + i]), r2[i], delta);
+   }
+
+   // explicit parameters
+   double p[3] = {1., 0., 1.};
+   f1.EvalN(n, x, r1, p);
+   for (Int_t i = 0; i < n; ++i)
+      EXPECT_NEAR(std::exp(-0.5 * x[i] * x[i]), r1[i], delta);
+
+   // Gauss-Legendre integration is exact for polynomials of low degree
+   TF1 fpol("fpol", "1 + 2*x + 3*x*x", 0, 1);
+   EXPECT_NEAR(3., fpol.IntegralFast(10, nullptr, nullptr, 0., 1.), 1e-12);
+}
+
+// IntegralFast of a derived class integrates the function defined by its EvalPar
+TEST(TF1, IntegralFastTF12)
+{
+   TF2 f2("f2", "x*x + 3*y", -1, 1, -1, 1);
+   TF12 fx("fx", &f2, 0.5, "x");
+   TF12 fy("fy", &f2, 0.5, "y");
+   EXPECT_NEAR(1. / 3. + 1.5, fx.IntegralFast(10, nullptr, nullptr, 0., 1.), 1e-12);
+   EXPECT_NEAR(0.25 + 1.5, fy.IntegralFast(10, nullptr, nullptr, 0., 1.), 1e-12);
+}
@@ -365,8 +365,22 @@ namespace FitUtil {
    */
    double EvaluatePoissonBinPdf(const IModelFunction & func, const BinData & data, const double * x, unsigned int ipoint, double * g = 0);
 
+   /**
+       return the number of chunks used for a multi-threaded evaluation of nEvents points (or SIMD vectors).
+       The chunks hold 1000 points each, independently of the size of the thread pool, so that the
+       partial sums are reduced in the same order and the result is identical for any number of threads.
+       The price is a loss of parallelism: at most nEvents/1000 chunks run concurrently, and fewer than
+       2000 points give a single chunk, which adjustExecutionPolicy runs serially.
+       Pass an explicit number of chunks to the evaluation functions to use more threads on small data sets.
+   */
    unsigned setAutomaticChunking(unsigned nEvents);
 
+   /**
+       return the execution policy to use for evaluating nEvents points (or SIMD vectors):
+       a multi-threaded evaluation which would run as a single chunk is done serially
+   */
+   ROOT::Fit::ExecutionPolicy adjustExecutionPolicy(ROOT::Fit::ExecutionPolicy executionPolicy, unsigned nEvents, unsigned nChunks);
+
    template<class T>
    struct Evaluate {
 #ifdef R__HAS_VECCORE
@@ -459,6 +473,7 @@ namespace FitUtil {
 #endif
 
          T res{};
+         executionPolicy = adjustExecutionPolicy(executionPolicy, data.Size() / vecSize, nChunks);
          if (executionPolicy == ROOT::Fit::ExecutionPolicy::kSerial) {
             ROOT::TSequentialExecutor pool;
             res = pool.MapReduce(mapFunction, ROOT::TSeq<unsigned>(0, data.Size()/vecSize), redFunction);
@@ -634,6 +649,7 @@ namespace FitUtil {
          T sumW_v{};
          T sumW2_v{};
          ROOT::Fit::FitUtil::LikelihoodAux<T> resArray;
+         executionPolicy = adjustExecutionPolicy(executionPolicy, numVectors, nChunks);
          if (executionPolicy == ROOT::Fit::ExecutionPolicy::kSerial) {
             ROOT::TSequentialExecutor pool;
             resArray = pool.MapReduce(mapFunction, ROOT::TSeq<unsigned>(0, data.Size() / vecSize), redFunction);
@@ -837,6 +853,7 @@ namespace FitUtil {
 #endif
 
          T res{};
+         executionPolicy = adjustExecutionPolicy(executionPolicy, data.Size() / vecSize, nChunks);
          if (executionPolicy == ROOT::Fit::ExecutionPolicy::kSerial) {
             for (unsigned int i = 0; i < (data.Size() / vecSize); i++) {
                res += mapFunction(i);
@@ -1009,6 +1026,7 @@ namespace FitUtil {
          }
 #endif
 
+         executionPolicy = adjustExecutionPolicy(executionPolicy, numVectors, nChunks);
          if (executionPolicy == ROOT::Fit::ExecutionPolicy::kSerial) {
             ROOT::TSequentialExecutor pool;
             gVec = pool.MapReduce(mapFunction, ROOT::TSeq<unsigned>(0, numVectors), redFunction);
@@ -1192,6 +1210,7 @@ namespace FitUtil {
          }
 #endif
 
+         executionPolicy = adjustExecutionPolicy(executionPolicy, numVectors, nChunks);
          if (executionPolicy == ROOT::Fit::ExecutionPolicy::kSerial) {
             ROOT::TSequentialExecutor pool;
             gVec = pool.MapReduce(mapFunction, ROOT::TSeq<unsigned>(0, numVectors), redFunction);
@@ -1342,6 +1361,7 @@ namespace FitUtil {
          }
 #endif
 
+         executionPolicy = adjustExecutionPolicy(executionPolicy, numVectors, nChunks);
          if (executionPolicy == ROOT::Fit::ExecutionPolicy::kSerial) {
             ROOT::TSequentialExecutor pool;
             gVec = pool.MapReduce(mapFunction, ROOT::TSeq<unsigned>(0, numVectors), redFunction);
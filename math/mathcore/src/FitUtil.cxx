@@ -384,6 +384,7 @@ namespace ROOT {
 #endif
 
   double res{};
+  executionPolicy = adjustExecutionPolicy(executionPolicy, data.Size(), nChunks);
   if(executionPolicy == ROOT::Fit::ExecutionPolicy::kSerial){
     for (unsigned int i=0; i<n; ++i) {
       res += mapFunction(i);
@@ -793,6 +794,7 @@ void FitUtil::EvaluateChi2Gradient(const IModelFunction &f, const BinData &data,
    }
 #endif
 
+   executionPolicy = adjustExecutionPolicy(executionPolicy, initialNPoints, nChunks);
    if (executionPolicy == ROOT::Fit::ExecutionPolicy::kSerial) {
       std::vector<std::vector<double>> allGradients(initialNPoints);
       for (unsigned int i = 0; i < initialNPoints; ++i) {
@@ -1033,6 +1035,7 @@ double FitUtil::EvaluateLogL(const IModelFunctionTempl<double> &func, const UnBi
   double logl{};
   double sumW{};
   double sumW2{};
+  executionPolicy = adjustExecutionPolicy(executionPolicy, data.Size(), nChunks);
   if(executionPolicy == ROOT::Fit::ExecutionPolicy::kSerial){
     for (unsigned int i=0; i<n; ++i) {
       auto resArray = mapFunction(i);
@@ -1210,6 +1213,7 @@ void FitUtil::EvaluateLogLGradient(const IModelFunction &f, const UnBinData &dat
    }
 #endif
 
+   executionPolicy = adjustExecutionPolicy(executionPolicy, initialNPoints, nChunks);
    if (executionPolicy == ROOT::Fit::ExecutionPolicy::kSerial) {
       std::vector<std::vector<double>> allGradients(initialNPoints);
       for (unsigned int i = 0; i < initialNPoints; ++i) {
@@ -1535,6 +1539,7 @@ double FitUtil::EvaluatePoissonLogL(const IModelFunction &func, const BinData &d
 #endif
 
    double res{};
+   executionPolicy = adjustExecutionPolicy(executionPolicy, data.Size(), nChunks);
    if (executionPolicy == ROOT::Fit::ExecutionPolicy::kSerial) {
       for (unsigned int i = 0; i < n; ++i) {
          res += mapFunction(i);
@@ -1703,6 +1708,7 @@ void FitUtil::EvaluatePoissonLogLGradient(const IModelFunction &f, const BinData
    }
 #endif
 
+   executionPolicy = adjustExecutionPolicy(executionPolicy, initialNPoints, nChunks);
    if (executionPolicy == ROOT::Fit::ExecutionPolicy::kSerial) {
       std::vector<std::vector<double>> allGradients(initialNPoints);
       for (unsigned int i = 0; i < initialNPoints; ++i) {
@@ -1745,12 +1751,19 @@ void FitUtil::EvaluatePoissonLogLGradient(const IModelFunction &f, const BinData
 
 
 unsigned FitUtil::setAutomaticChunking(unsigned nEvents){
-      auto ncpu  = ROOT::GetImplicitMTPoolSize();
-      if (nEvents/ncpu < 1000) return ncpu;
-      return nEvents/1000;
+      // The chunks do not depend on the number of threads, so that the order
+      // of the partial sums, and thus the result, is the same for any pool size
+      return std::max(1u, nEvents/1000);
       //return ((nEvents/ncpu + 1) % 1000) *40 ; //arbitrary formula
 }
 
+ROOT::Fit::ExecutionPolicy FitUtil::adjustExecutionPolicy(ROOT::Fit::ExecutionPolicy executionPolicy, unsigned nEvents, unsigned nChunks){
+   // small data sets are not worth the overhead of the thread pool
+   if (executionPolicy == ROOT::Fit::ExecutionPolicy::kMultithread && nChunks == 0 && setAutomaticChunking(nEvents) < 2)
+      return ROOT::Fit::ExecutionPolicy::kSerial;
+   return executionPolicy;
+}
+
 }
 
 } // end namespace ROOT
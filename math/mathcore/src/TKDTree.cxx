@@ -16,6 +16,11 @@
 #include <string.h>
 #include <limits>
 
+#ifdef R__USE_IMT
+#include "TROOT.h"
+#include "ROOT/TThreadExecutor.hxx"
+#endif
+
 templateClassImp(TKDTree);
 
 
@@ -406,6 +411,10 @@ TKDTree<Index, Value>::~TKDTree()
 ///
 /// The tree is divided recursively. See class description, section 4b for the details
 /// of the division alogrithm
+///
+/// If implicit multi-threading is enabled (ROOT::EnableImplicitMT()), large trees
+/// are built in parallel: independent subtrees are divided in different threads.
+/// The resulting tree is identical to the one built serially.
 
 template <typename  Index, typename Value>
 void TKDTree<Index, Value>::Build()
@@ -449,76 +458,64 @@ void TKDTree<Index, Value>::Build()
    //
    //
    //4.
+#ifdef R__USE_IMT
+   // The two daughters of a node partition disjoint ranges of fIndPoints and
+   // fill disjoint sets of nodes, so independent subtrees can be built in
+   // parallel. The top rows are split serially until there are enough
+   // subtrees to keep all the threads busy.
+   if (ROOT::IsImplicitMTEnabled() && fNPoints > 16384 && fNPoints/fBucketSize > 1) {
+      struct SubTree { Int_t fNode, fRow, fPos, fNPoints; };
+      const UInt_t ntasks = 4*ROOT::GetImplicitMTPoolSize();
+      std::vector<SubTree> tasks(1, SubTree{0, 0, 0, fNPoints});
+      while (tasks.size() < ntasks) {
+         std::vector<SubTree> next;
+         for (auto &t : tasks) {
+            if (t.fNPoints <= fBucketSize) continue;
+            Int_t nleft = SplitNode(t.fNode, t.fRow, t.fPos, t.fNPoints);
+            next.push_back(SubTree{t.fNode*2+1, t.fRow+1, t.fPos, nleft});
+            next.push_back(SubTree{t.fNode*2+2, t.fRow+1, t.fPos+nleft, t.fNPoints-nleft});
+         }
+         if (next.empty()) break;
+         tasks.swap(next);
+      }
+      ROOT::TThreadExecutor pool;
+      pool.Foreach([this](const SubTree &t) { BuildSubtree(t.fNode, t.fRow, t.fPos, t.fNPoints); }, tasks);
+      return;
+   }
+#endif
+   BuildSubtree(0, 0, 0, fNPoints);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Build the part of the tree below node cnode, sitting in row crow, which
+/// contains the npoints points starting at cpos in fIndPoints.
+/// Non recursive: the nodes still to be split are kept on a stack.
+
+template <typename  Index, typename Value>
+void TKDTree<Index, Value>::BuildSubtree(Int_t cnode, Int_t crow, Int_t cpos, Int_t npoints)
+{
    //    stack for non recursive build - size 128 bytes enough
    Int_t rowStack[128];
    Int_t nodeStack[128];
    Int_t npointStack[128];
    Int_t posStack[128];
    Int_t currentIndex = 0;
-   Int_t iter =0;
-   rowStack[0]    = 0;
-   nodeStack[0]   = 0;
-   npointStack[0] = fNPoints;
-   posStack[0]   = 0;
+   rowStack[0]    = crow;
+   nodeStack[0]   = cnode;
+   npointStack[0] = npoints;
+   posStack[0]    = cpos;
    //
-   Int_t nbucketsall =0;
    while (currentIndex>=0){
-      iter++;
-      //
-      Int_t npoints  = npointStack[currentIndex];
+      npoints  = npointStack[currentIndex];
       if (npoints<=fBucketSize) {
-         //printf("terminal node : index %d iter %d\n", currentIndex, iter);
          currentIndex--;
-         nbucketsall++;
          continue; // terminal node
       }
-      Int_t crow     = rowStack[currentIndex];
-      Int_t cpos     = posStack[currentIndex];
-      Int_t cnode    = nodeStack[currentIndex];
-      //printf("currentIndex %d npoints %d node %d\n", currentIndex, npoints, cnode);
-      //
-      // divide points
-      Int_t nbuckets0 = npoints/fBucketSize;           //current number of  buckets
-      if (npoints%fBucketSize) nbuckets0++;            //
-      Int_t restRows = fRowT0-rowStack[currentIndex];  // rest of fully occupied node row
-      if (restRows<0) restRows =0;
-      for (;nbuckets0>(2<<restRows); restRows++) {}
-      Int_t nfull = 1<<restRows;
-      Int_t nrest = nbuckets0-nfull;
-      Int_t nleft =0, nright =0;
-      //
-      if (nrest>(nfull/2)){
-         nleft  = nfull*fBucketSize;
-         nright = npoints-nleft;
-      }else{
-         nright = nfull*fBucketSize/2;
-         nleft  = npoints-nright;
-      }
-
-      //
-      //find the axis with biggest spread
-      Value maxspread=0;
-      Value tempspread, min, max;
-      Index axspread=0;
-      Value *array;
-      for (Int_t idim=0; idim<fNDim; idim++){
-         array = fData[idim];
-         Spread(npoints, array, fIndPoints+cpos, min, max);
-         tempspread = max - min;
-         if (maxspread < tempspread) {
-            maxspread=tempspread;
-            axspread = idim;
-         }
-         if(cnode) continue;
-         //printf("set %d %6.3f %6.3f\n", idim, min, max);
-         fRange[2*idim] = min; fRange[2*idim+1] = max;
-      }
-      array = fData[axspread];
-      KOrdStat(npoints, array, nleft, fIndPoints+cpos);
-      fAxis[cnode]  = axspread;
-      fValue[cnode] = array[fIndPoints[cpos+nleft]];
-      //printf("Set node %d : ax %d val %f\n", cnode, node->fAxis, node->fValue);
-      //
+      crow     = rowStack[currentIndex];
+      cpos     = posStack[currentIndex];
+      cnode    = nodeStack[currentIndex];
+      Int_t nleft  = SplitNode(cnode, crow, cpos, npoints);
+      Int_t nright = npoints-nleft;
       //
       npointStack[currentIndex] = nleft;
       rowStack[currentIndex]    = crow+1;
@@ -539,6 +536,57 @@ void TKDTree<Index, Value>::Build()
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Set the cutting axis and value of the non terminal node cnode, sitting in
+/// row crow, which contains the npoints points starting at cpos in fIndPoints.
+/// The points are reordered so that the ones of the left daughter come first.
+/// Returns the number of points in the left daughter.
+
+template <typename  Index, typename Value>
+Int_t TKDTree<Index, Value>::SplitNode(Int_t cnode, Int_t crow, Int_t cpos, Int_t npoints)
+{
+   // divide points
+   Int_t nbuckets0 = npoints/fBucketSize;           //current number of  buckets
+   if (npoints%fBucketSize) nbuckets0++;            //
+   Int_t restRows = fRowT0-crow;                    // rest of fully occupied node row
+   if (restRows<0) restRows =0;
+   for (;nbuckets0>(2<<restRows); restRows++) {}
+   Int_t nfull = 1<<restRows;
+   Int_t nrest = nbuckets0-nfull;
+   Int_t nleft =0;
+   //
+   if (nrest>(nfull/2)){
+      nleft  = nfull*fBucketSize;
+   }else{
+      nleft  = npoints-nfull*fBucketSize/2;
+   }
+
+   //
+   //find the axis with biggest spread
+   Value maxspread=0;
+   Value tempspread, min, max;
+   Index axspread=0;
+   Value *array;
+   for (Int_t idim=0; idim<fNDim; idim++){
+      array = fData[idim];
+      Spread(npoints, array, fIndPoints+cpos, min, max);
+      tempspread = max - min;
+      if (maxspread < tempspread) {
+         maxspread=tempspread;
+         axspread = idim;
+      }
+      if(cnode) continue;
+      //printf("set %d %6.3f %6.3f\n", idim, min, max);
+      fRange[2*idim] = min; fRange[2*idim+1] = max;
+   }
+   array = fData[axspread];
+   KOrdStat(npoints, array, nleft, fIndPoints+cpos);
+   fAxis[cnode]  = axspread;
+   fValue[cnode] = array[fIndPoints[cpos+nleft]];
+   //printf("Set node %d : ax %d val %f\n", cnode, node->fAxis, node->fValue);
+   return nleft;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 ///Find kNN nearest neighbors to the point in the first argument
 ///Returns 1 on success, 0 on failure
@@ -561,6 +609,42 @@ void TKDTree<Index, Value>::FindNearestNeighbors(const Value *point, const Int_t
 
 }
 
+////////////////////////////////////////////////////////////////////////////////
+///Find the kNN nearest neighbors of each of the npoints points of the second argument
+///The coordinates of point i are points[i*ndim] ... points[i*ndim+ndim-1]
+///The indexes and distances of its neighbors are returned in ind[i*kNN] ... ind[i*kNN+kNN-1]
+///and dist[i*kNN] ... dist[i*kNN+kNN-1]: arrays ind and dist are provided by the user and
+///are assumed to be at least npoints*kNN elements long
+///If implicit multi-threading is enabled the points are processed in parallel
+
+template <typename  Index, typename Value>
+void TKDTree<Index, Value>::FindNearestNeighbors(Int_t npoints, const Value *points, const Int_t kNN, Index *ind, Value *dist)
+{
+   if (!ind || !dist) {
+      Error("FindNearestNeighbors", "Working arrays must be allocated by the user!");
+      return;
+   }
+   // the boundaries are built lazily: do it once before the (possibly parallel) queries
+   MakeBoundariesExact();
+   auto findPoint = [&](Int_t ipoint) {
+      Index *pind  = ind  + Long64_t(ipoint)*kNN;
+      Value *pdist = dist + Long64_t(ipoint)*kNN;
+      for (Int_t i=0; i<kNN; i++){
+         pdist[i]=std::numeric_limits<Value>::max();
+         pind[i]=-1;
+      }
+      UpdateNearestNeighbors(0, points + Long64_t(ipoint)*fNDim, kNN, pind, pdist);
+   };
+#ifdef R__USE_IMT
+   if (ROOT::IsImplicitMTEnabled() && npoints > 1) {
+      ROOT::TThreadExecutor pool;
+      pool.Foreach(findPoint, ROOT::TSeq<Int_t>(0, npoints));
+      return;
+   }
+#endif
+   for (Int_t ipoint=0; ipoint<npoints; ipoint++) findPoint(ipoint);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 ///Update the nearest neighbors values by examining the node inode
 
@@ -757,11 +841,36 @@ void TKDTree<Index, Value>::FindInRange(Value * point, Value range, std::vector<
    UpdateRange(0, point, range, res);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+///Find all points in the sphere of a given radius "range" around each of the npoints
+///points of the second argument
+///The coordinates of point i are points[i*ndim] ... points[i*ndim+ndim-1]
+///and the indexes of the points found around it are appended to res[i]
+///If implicit multi-threading is enabled the points are processed in parallel
+
+template <typename  Index, typename Value>
+void TKDTree<Index, Value>::FindInRange(Int_t npoints, const Value *points, Value range, std::vector<std::vector<Index> > &res)
+{
+   MakeBoundariesExact();
+   res.resize(npoints);
+   auto findPoint = [&](Int_t ipoint) {
+      UpdateRange(0, points + Long64_t(ipoint)*fNDim, range, res[ipoint]);
+   };
+#ifdef R__USE_IMT
+   if (ROOT::IsImplicitMTEnabled() && npoints > 1) {
+      ROOT::TThreadExecutor pool;
+      pool.Foreach(findPoint, ROOT::TSeq<Int_t>(0, npoints));
+      return;
+   }
+#endif
+   for (Int_t ipoint=0; ipoint<npoints; ipoint++) findPoint(ipoint);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 ///Internal recursive function with the implementation of range searches
 
 template <typename  Index, typename Value>
-void TKDTree<Index, Value>::UpdateRange(Index inode, Value* point, Value range, std::vector<Index> &res)
+void TKDTree<Index, Value>::UpdateRange(Index inode, const Value* point, Value range, std::vector<Index> &res)
 {
    Value min, max;
    DistanceToNode(point, inode, min, max);
@@ -0,0 +1,63 @@
+// Tests that the multi-threaded evaluation of the fit methods does not depend on the size of the thread pool
+
+#include "Fit/FitUtil.h"
+#include "Fit/BinData.h"
+#include "Fit/UnBinData.h"
+#include "Math/WrappedParamFunction.h"
+#include "TROOT.h"
+#include "TRandom3.h"
+#include "RConfigure.h"
+
+#include "gtest/gtest.h"
+
+#include <cmath>
+
+#ifdef R__USE_IMT
+
+static double GausPdf(const double *x, const double *p)
+{
+   const double t = (x[0] - p[0]) / p[1];
+   return std::exp(-0.5 * t * t) / (std::sqrt(2. * M_PI) * p[1]);
+}
+
+// Number of points: the chunking that depended on the pool size gave 3 and 4 chunks for 2 and 4 threads
+static const unsigned n = 3000;
+
+// Evaluate the chi2 and the log-likelihood with a thread pool of the given size
+static void EvaluateWithPool(unsigned nThreads, double &chi2, double &logL)
+{
+   const double truePar[2] = {0., 1.};
+   TRandom3 rndm(4357);
+   ROOT::Fit::BinData binData(n, 1);
+   ROOT::Fit::UnBinData unbinData(n, 1);
+   for (unsigned i = 0; i < n; ++i) {
+      const double x = -5. + 10. * (i + 0.5) / n;
+      binData.Add(x, rndm.Gaus(GausPdf(&x, truePar), 0.01), 0.01);
+      unbinData.Add(rndm.Gaus(0.2, 1.1));
+   }
+
+   double par[2] = {0.1, 1.2};
+   ROOT::Math::WrappedParamFunction<> func(&GausPdf, 1, 2, par);
+
+   ROOT::EnableImplicitMT(nThreads);
+   unsigned nPoints = 0;
+   chi2 = ROOT::Fit::FitUtil::EvaluateChi2(func, binData, par, nPoints, ROOT::Fit::ExecutionPolicy::kMultithread);
+   logL = ROOT::Fit::FitUtil::EvaluateLogL(func, unbinData, par, 0, false, nPoints,
+                                           ROOT::Fit::ExecutionPolicy::kMultithread);
+   ROOT::DisableImplicitMT();
+}
+
+// The partial sums are reduced in the same order for any number of threads
+TEST(FitUtil, MultithreadReproducible)
+{
+   EXPECT_EQ(ROOT::Fit::FitUtil::setAutomaticChunking(n), 3u);
+
+   double chi2A, logLA, chi2B, logLB;
+   EvaluateWithPool(2, chi2A, logLA);
+   EvaluateWithPool(4, chi2B, logLB);
+
+   EXPECT_EQ(chi2A, chi2B);
+   EXPECT_EQ(logLA, logLB);
+}
+
+#endif
@@ -5,6 +5,7 @@
   TestSpeed();       // test the CPU consumption to build kdTree
   TestkdtreeIF();    // test functionality of the kdTree
   TestSizeIF();      // test the size of kdtree - search application - Alice TPC tracker situation
+  TestBatch();       // test the parallel build and the batch queries
   //
 */
 
@@ -17,7 +18,10 @@
 #include "TKDTree.h"
 #include "TApplication.h"
 #include "TCanvas.h"
+#include "TROOT.h"
+#include <algorithm>
 #include <iostream>
+#include <vector>
 
 
 bool showGraphics = false;
@@ -26,6 +30,7 @@ bool showGraphics = false;
 void TestBuild(const Int_t npoints = 1000000, const Int_t bsize = 100);
 void TestConstr(const Int_t npoints = 1000000, const Int_t bsize = 100);
 void TestSpeed(Int_t npower2 = 20, Int_t bsize = 10);
+Int_t TestBatch(Int_t npoints = 100000, Int_t bsize = 10);
 
 //void TestkdtreeIF(Int_t npoints=1000, Int_t bsize=9, Int_t nloop=1000, Int_t mode = 2);
 //void TestSizeIF(Int_t nsec=36, Int_t nrows=159, Int_t npoints=1000,  Int_t bsize=10, Int_t mode=1);
@@ -45,12 +50,14 @@ Float_t Mem()
 ///
 ///
 
-void kDTreeTest()
+Int_t kDTreeTest()
 {
   printf("\n\tTesting kDTree memory usage ...\n");
   TestBuild();
   printf("\n\tTesting kDTree speed ...\n");
   TestSpeed();
+  printf("\n\tTesting kDTree parallel build and batch queries ...\n");
+  return TestBatch();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -552,6 +559,81 @@ void TestRange()
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+///Test the parallel TKDTree::Build() and the batch versions of
+///TKDTree::FindNearestNeighbors() and TKDTree::FindInRange()
+///Returns the number of differences found
+
+Int_t TestBatch(Int_t npoints, Int_t bsize)
+{
+   const Int_t nq = 1000;
+   const Int_t nn = 10;
+   const Double_t range = 5;
+   std::vector<Double_t> x(npoints), y(npoints), z(npoints);
+   for (Int_t i=0; i<npoints; i++){
+      x[i] = gRandom->Uniform(-100, 100);
+      y[i] = gRandom->Uniform(-100, 100);
+      z[i] = gRandom->Uniform(-100, 100);
+   }
+   // query points, one after the other
+   std::vector<Double_t> q(3*nq);
+   for (Int_t i=0; i<3*nq; i++) q[i] = gRandom->Uniform(-90, 90);
+
+   // reference tree, built serially
+   TKDTreeID kdtree1(npoints, 3, bsize);
+   kdtree1.SetData(0, x.data());
+   kdtree1.SetData(1, y.data());
+   kdtree1.SetData(2, z.data());
+   kdtree1.Build();
+
+#ifdef R__USE_IMT
+   ROOT::EnableImplicitMT(4);
+#endif
+   TKDTreeID kdtree2(npoints, 3, bsize);
+   kdtree2.SetData(0, x.data());
+   kdtree2.SetData(1, y.data());
+   kdtree2.SetData(2, z.data());
+   kdtree2.Build();
+
+   Int_t ndiff = 0;
+   // the two trees must be identical
+   if (kdtree1.GetNNodes() != kdtree2.GetNNodes()) ndiff++;
+   for (Int_t inode=0; inode<kdtree1.GetNNodes(); inode++){
+      if (kdtree1.GetNodeAxis(inode) != kdtree2.GetNodeAxis(inode) ||
+          kdtree1.GetNodeValue(inode) != kdtree2.GetNodeValue(inode)) ndiff++;
+   }
+   for (Int_t i=0; i<npoints; i++){
+      if (kdtree1.GetIndPoints()[i] != kdtree2.GetIndPoints()[i]) ndiff++;
+   }
+   printf("%d differences found between the serial and the parallel build\n", ndiff);
+
+   // batch queries against one point at a time
+   std::vector<Int_t> ind(nq*nn), ind1(nn);
+   std::vector<Double_t> dist(nq*nn), dist1(nn);
+   kdtree2.FindNearestNeighbors(nq, q.data(), nn, ind.data(), dist.data());
+   std::vector<std::vector<Int_t> > res;
+   kdtree2.FindInRange(nq, q.data(), range, res);
+   Int_t nbatch = 0;
+   std::vector<Int_t> res1;
+   for (Int_t iq=0; iq<nq; iq++){
+      kdtree1.FindNearestNeighbors(&q[3*iq], nn, ind1.data(), dist1.data());
+      for (Int_t inn=0; inn<nn; inn++){
+         if (ind[iq*nn+inn] != ind1[inn] || dist[iq*nn+inn] != dist1[inn]) nbatch++;
+      }
+      res1.clear();
+      kdtree1.FindInRange(&q[3*iq], range, res1);
+      std::sort(res1.begin(), res1.end());
+      std::sort(res[iq].begin(), res[iq].end());
+      if (res1 != res[iq]) nbatch++;
+   }
+   printf("%d differences found between the batch and the single point queries\n", nbatch);
+
+#ifdef R__USE_IMT
+   ROOT::DisableImplicitMT();
+#endif
+   return ndiff + nbatch;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 int main(int argc, char **argv) {
@@ -579,7 +661,7 @@ int main(int argc, char **argv) {
    if ( showGraphics )
       theApp = new TApplication("App",&argc,argv);
 
-   kDTreeTest();
+   Int_t ret = kDTreeTest();
 
    if ( showGraphics )
    {
@@ -588,5 +670,5 @@ int main(int argc, char **argv) {
       theApp = 0;
    }
 
-   return 0;
+   return ret ? 1 : 0;
 }
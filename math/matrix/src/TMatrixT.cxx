@@ -19,6 +19,7 @@
 
 #include <iostream>
 #include <typeinfo>
+#include <algorithm>
 
 #include "TMatrixT.h"
 #include "TBuffer.h"
@@ -3070,50 +3071,76 @@ TMatrixT<Element> &ElementDiv(TMatrixT<Element> &target,const TMatrixTSym<Elemen
    return target;
 }
 
+namespace {
+   // Block sizes of the matrix multiplication kernels: a block of kMultColBlock
+   // columns of kMultInnerBlock rows of B (128 kB for doubles) stays in the cache
+   // while it is combined with all rows of A.
+   const Int_t kMultColBlock   = 256;
+   const Int_t kMultInnerBlock = 64;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Elementary routine to calculate matrix multiplication A*B
+///
+/// Row i of C is accumulated as the sum over k of A[i,k] times row k of B, so
+/// that the innermost loop runs with unit stride over B and C and can be
+/// vectorized. The loops over the columns of B and over k are blocked to keep
+/// the used part of B in the cache. For every element of C the products are
+/// still summed in order of increasing k.
 
 template<class Element>
 void AMultB(const Element * const ap,Int_t na,Int_t ncolsa,
             const Element * const bp,Int_t nb,Int_t ncolsb,Element *cp)
 {
-   const Element *arp0 = ap;                     // Pointer to  A[i,0];
-   while (arp0 < ap+na) {
-      for (const Element *bcp = bp; bcp < bp+ncolsb; ) { // Pointer to the j-th column of B, Start bcp = B[0,0]
-         const Element *arp = arp0;                       // Pointer to the i-th row of A, reset to A[i,0]
-         Element cij = 0;
-         while (bcp < bp+nb) {                     // Scan the i-th row of A and
-            cij += *arp++ * *bcp;                   // the j-th col of B
-            bcp += ncolsb;
+   if (ncolsa <= 0 || ncolsb <= 0) return;
+   const Int_t nrowsa = na/ncolsa;
+   const Int_t nrowsb = nb/ncolsb;
+   std::fill(cp,cp+nrowsa*ncolsb,Element(0));
+
+   for (Int_t j0 = 0; j0 < ncolsb; j0 += kMultColBlock) {
+      const Int_t j1 = TMath::Min(j0+kMultColBlock,ncolsb);
+      for (Int_t k0 = 0; k0 < nrowsb; k0 += kMultInnerBlock) {
+         const Int_t k1 = TMath::Min(k0+kMultInnerBlock,nrowsb);
+         for (Int_t i = 0; i < nrowsa; i++) {
+            const Element * const arp = ap+i*ncolsa;  // Pointer to A[i,0]
+                  Element * const crp = cp+i*ncolsb;  // Pointer to C[i,0]
+            for (Int_t k = k0; k < k1; k++) {
+               const Element aik = arp[k];
+               const Element * const brp = bp+k*ncolsb; // Pointer to B[k,0]
+               for (Int_t j = j0; j < j1; j++)
+                  crp[j] += aik*brp[j];
+            }
          }
-         *cp++ = cij;
-         bcp -= nb-1;                              // Set bcp to the (j+1)-th col
       }
-      arp0 += ncolsa;                             // Set ap to the (i+1)-th row
    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Elementary routine to calculate matrix multiplication A^T*B
+///
+/// Row i of C is accumulated as the sum over k of A[k,i] times row k of B,
+/// see AMultB.
 
 template<class Element>
 void AtMultB(const Element * const ap,Int_t ncolsa,
              const Element * const bp,Int_t nb,Int_t ncolsb,Element *cp)
 {
-   const Element *acp0 = ap;           // Pointer to  A[i,0];
-   while (acp0 < ap+ncolsa) {
-      for (const Element *bcp = bp; bcp < bp+ncolsb; ) { // Pointer to the j-th column of B, Start bcp = B[0,0]
-         const Element *acp = acp0;                       // Pointer to the i-th column of A, reset to A[0,i]
-         Element cij = 0;
-         while (bcp < bp+nb) {           // Scan the i-th column of A and
-            cij += *acp * *bcp;           // the j-th col of B
-            acp += ncolsa;
-            bcp += ncolsb;
+   if (ncolsa <= 0 || ncolsb <= 0) return;
+   const Int_t nrowsb = nb/ncolsb;             // = number of rows of A
+   std::fill(cp,cp+ncolsa*ncolsb,Element(0));
+
+   for (Int_t j0 = 0; j0 < ncolsb; j0 += kMultColBlock) {
+      const Int_t j1 = TMath::Min(j0+kMultColBlock,ncolsb);
+      for (Int_t k = 0; k < nrowsb; k++) {
+         const Element * const akp = ap+k*ncolsa; // Pointer to A[k,0]
+         const Element * const brp = bp+k*ncolsb; // Pointer to B[k,0]
+         for (Int_t i = 0; i < ncolsa; i++) {
+            const Element aki = akp[i];
+                  Element * const crp = cp+i*ncolsb; // Pointer to C[i,0]
+            for (Int_t j = j0; j < j1; j++)
+               crp[j] += aki*brp[j];
          }
-         *cp++ = cij;
-         bcp -= nb-1;                    // Set bcp to the (j+1)-th col
       }
-      acp0++;                           // Set acp0 to the (i+1)-th col
    }
 }
 
@@ -0,0 +1,59 @@
+#include "gtest/gtest.h"
+
+#include "TMatrixD.h"
+#include "TMatrixF.h"
+
+// Matrix with small integer elements, so that all products and sums are exact
+template <class Element>
+static TMatrixT<Element> IntegerMatrix(Int_t nrows, Int_t ncols, Int_t seed)
+{
+   TMatrixT<Element> m(nrows, ncols);
+   for (Int_t i = 0; i < nrows; ++i)
+      for (Int_t j = 0; j < ncols; ++j)
+         m(i, j) = Element((i * 7 + j * 3 + seed) % 11 - 5);
+   return m;
+}
+
+template <class Element>
+static void CheckMultiplication(Int_t n, Int_t m, Int_t p)
+{
+   // C = A * B, with A n x m and B m x p
+   const TMatrixT<Element> a = IntegerMatrix<Element>(n, m, 1);
+   const TMatrixT<Element> b = IntegerMatrix<Element>(m, p, 2);
+   const TMatrixT<Element> c(a, TMatrixT<Element>::kMult, b);
+   ASSERT_EQ(c.GetNrows(), n);
+   ASSERT_EQ(c.GetNcols(), p);
+   for (Int_t i = 0; i < n; ++i) {
+      for (Int_t j = 0; j < p; ++j) {
+         Element sum = 0;
+         for (Int_t k = 0; k < m; ++k)
+            sum += a(i, k) * b(k, j);
+         EXPECT_EQ(c(i, j), sum) << "A*B element (" << i << "," << j << ")";
+      }
+   }
+
+   // D = A^T * E, with A n x m and E n x p
+   const TMatrixT<Element> e = IntegerMatrix<Element>(n, p, 3);
+   const TMatrixT<Element> d(a, TMatrixT<Element>::kTransposeMult, e);
+   ASSERT_EQ(d.GetNrows(), m);
+   ASSERT_EQ(d.GetNcols(), p);
+   for (Int_t i = 0; i < m; ++i) {
+      for (Int_t j = 0; j < p; ++j) {
+         Element sum = 0;
+         for (Int_t k = 0; k < n; ++k)
+            sum += a(k, i) * e(k, j);
+         EXPECT_EQ(d(i, j), sum) << "A^T*E element (" << i << "," << j << ")";
+      }
+   }
+}
+
+// The blocked multiplication kernels agree with a naive triple loop. The sizes are not multiples
+// of the blocks (256 columns of B, 64 rows of B), such that the edge blocks are partial.
+TEST(TMatrixT, MultiplicationBlocks)
+{
+   CheckMultiplication<Double_t>(1, 1, 1);
+   CheckMultiplication<Double_t>(5, 3, 7);
+   CheckMultiplication<Double_t>(13, 150, 300);
+   CheckMultiplication<Double_t>(70, 65, 257);
+   CheckMultiplication<Float_t>(9, 130, 270);
+}
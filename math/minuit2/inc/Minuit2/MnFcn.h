@@ -42,6 +42,11 @@ public:
   virtual double operator()(const MnAlgebraicVector&) const;
   unsigned int NumOfCalls() const {return fNumCall;}
 
+  /// evaluate the function without increasing the number of calls; used by the
+  /// parallel loops, which count their calls per thread and add them with AddNumOfCalls
+  virtual double CallWithoutCounting(const MnAlgebraicVector&) const;
+  void AddNumOfCalls(int ncall) const {fNumCall += ncall;}
+
   //
   //forward interface
   //
@@ -32,7 +32,7 @@ public:
 
   ~MnUserFcn() {}
 
-  virtual double operator()(const MnAlgebraicVector&) const;
+  virtual double CallWithoutCounting(const MnAlgebraicVector&) const;
 
 private:
 
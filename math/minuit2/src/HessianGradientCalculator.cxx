@@ -85,12 +85,23 @@ std::pair<FunctionGradient, MnAlgebraicVector> HessianGradientCalculator::DeltaG
    unsigned int n = x.size();
    MnAlgebraicVector dgrd(n);
 
+   // the calls are counted locally (per thread with OpenMP) and added to the FCN counter at the end
+   int ncall = 0;
+
+#ifndef _OPENMP
    MPIProcess mpiproc(n,0);
    // initial starting values
    unsigned int startElementIndex = mpiproc.StartElementIndex();
    unsigned int endElementIndex = mpiproc.EndElementIndex();
 
    for(unsigned int i = startElementIndex; i < endElementIndex; i++) {
+#else
+   // parallelize this loop using OpenMP, as in Numerical2PGradientCalculator
+#pragma omp parallel for reduction(+:ncall)
+   for(int i = 0; i < int(n); i++) {
+      // each thread uses its own copy of the parameters
+      MnAlgebraicVector x = par.Vec();
+#endif
       double xtf = x(i);
       double dmin = 4.*Precision().Eps2()*(xtf + Precision().Eps2());
       double epspri = Precision().Eps2() + fabs(grd(i)*Precision().Eps2());
@@ -104,10 +115,11 @@ std::pair<FunctionGradient, MnAlgebraicVector> HessianGradientCalculator::DeltaG
       double grdnew = 0.;
       for(unsigned int j = 0; j < Ncycle(); j++)  {
          x(i) = xtf + d;
-         double fs1 = Fcn()(x);
+         double fs1 = Fcn().CallWithoutCounting(x);
          x(i) = xtf - d;
-         double fs2 = Fcn()(x);
+         double fs2 = Fcn().CallWithoutCounting(x);
          x(i) = xtf;
+         ncall += 2;
          //       double sag = 0.5*(fs1+fs2-2.*fcnmin);
          //LM: should I calculate also here second derivatives ???
 
@@ -137,9 +149,13 @@ std::pair<FunctionGradient, MnAlgebraicVector> HessianGradientCalculator::DeltaG
 
    }
 
+   Fcn().AddNumOfCalls(ncall);
+
+#ifndef _OPENMP
    mpiproc.SyncVector(grd);
    mpiproc.SyncVector(gstep);
    mpiproc.SyncVector(dgrd);
+#endif
 
    return std::pair<FunctionGradient, MnAlgebraicVector>(FunctionGradient(grd, g2, gstep), dgrd);
 }
@@ -23,6 +23,11 @@ MnFcn::~MnFcn() {
 double MnFcn::operator()(const MnAlgebraicVector& v) const {
    // evaluate FCN converting from from MnAlgebraicVector to std::vector
    fNumCall++;
+   return CallWithoutCounting(v);
+}
+
+double MnFcn::CallWithoutCounting(const MnAlgebraicVector& v) const {
+   // evaluate FCN without increasing the number of calls
    return fFCN(MnVectorTransform()(v));
 }
 
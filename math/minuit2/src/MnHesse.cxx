@@ -245,6 +245,28 @@ L30:
 
    //off-diagonal Elements
    // initial starting values
+#ifdef _OPENMP
+   // the n*(n-1)/2 function calls are independent: distribute the rows among
+   // the threads (dynamically, since the rows have different lengths)
+   // FCN must be thread-safe, as for the parallel gradient calculation
+   // the calls are counted per thread and added to the FCN counter at the end
+   int ncallOffDiagonal = 0;
+#pragma omp parallel for schedule(dynamic) reduction(+:ncallOffDiagonal)
+   for (int i = 0; i < int(n) - 1; i++) {
+      // each thread uses its own copy of the parameters
+      MnAlgebraicVector xi = x;
+      xi(i) += dirin(i);
+      for (unsigned int j = i + 1; j < n; j++) {
+         xi(j) += dirin(j);
+         double fs1 = mfcn.CallWithoutCounting(xi);
+         ncallOffDiagonal++;
+         double elem = (fs1 + amin - yy(i) - yy(j))/(dirin(i)*dirin(j));
+         vhmat(i,j) = elem;
+         xi(j) -= dirin(j);
+      }
+   }
+   mfcn.AddNumOfCalls(ncallOffDiagonal);
+#else
    if (n > 0) { 
       MPIProcess mpiprocOffDiagonal(n*(n-1)/2,0);
       unsigned int startParIndexOffDiagonal = mpiprocOffDiagonal.StartElementIndex();
@@ -279,6 +301,7 @@ L30:
 
       mpiprocOffDiagonal.SyncSymMatrixOffDiagonal(vhmat);
    }
+#endif
 
    //verify if matrix pos-def (still 2nd derivative)
 
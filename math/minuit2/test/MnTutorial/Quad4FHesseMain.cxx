@@ -0,0 +1,95 @@
+// @(#)root/minuit2:$Id$
+// Authors: M. Winkler, F. James, L. Moneta, A. Zsenei   2003-2005
+
+/**********************************************************************
+ *                                                                    *
+ * Copyright (c) 2005 LCG ROOT Math team,  CERN/PH-SFT                *
+ *                                                                    *
+ **********************************************************************/
+
+// Hesse on a quadratic function with known second derivatives. When Minuit2 is
+// built with OpenMP, the result and the number of function calls must not
+// depend on the number of threads.
+
+#include "Quad4F.h"
+#include "Minuit2/MnHesse.h"
+#include "Minuit2/MnUserParameters.h"
+#include "Minuit2/MnUserParameterState.h"
+#include "Minuit2/MnPrint.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include <cmath>
+#include <iostream>
+
+using namespace ROOT::Minuit2;
+
+// run Hesse with strategy 2, which also refines the gradient, at a point away from the minimum
+MnUserParameterState RunHesse(const Quad4F & fcn) {
+  MnUserParameters upar;
+  upar.Add("x", 0.3, 0.1);
+  upar.Add("y", -0.2, 0.1);
+  upar.Add("z", 0.5, 0.1);
+  upar.Add("w", 0.1, 0.1);
+  MnHesse hesse(2);
+  return hesse(fcn, upar);
+}
+
+int main() {
+
+  Quad4F fcn;
+  int iret = 0;
+
+  MnUserParameterState state = RunHesse(fcn);
+  std::cout << "state after hesse: " << state << std::endl;
+  if (!state.HasCovariance()) {
+     std::cerr << "Hesse failed" << std::endl;
+     return 1;
+  }
+
+  // the covariance is 2*Up times the inverse of the matrix of second derivatives
+  const double hess[4][4] = { { 42./70.,       0., -14./70., 0. },
+                              {      0.,  40./70., -20./70., 0. },
+                              { -14./70., -20./70.,  38./70., 0. },
+                              {      0.,       0.,       0., 2. } };
+  const MnUserCovariance & cov = state.Covariance();
+  for (unsigned int i = 0; i < 4; i++) {
+     for (unsigned int j = 0; j < 4; j++) {
+        double prod = 0;
+        for (unsigned int k = 0; k < 4; k++)
+           prod += cov(i,k) * hess[k][j] / (2. * fcn.Up());
+        if (std::fabs(prod - (i == j ? 1. : 0.)) > 1.E-4) {
+           std::cerr << "covariance times second derivatives differs from unity at (" << i << "," << j << "): " << prod << std::endl;
+           iret = 2;
+        }
+     }
+  }
+
+#ifdef _OPENMP
+  // compare a single thread with several threads
+  const int nthreads = omp_get_max_threads();
+  omp_set_num_threads(1);
+  MnUserParameterState serial = RunHesse(fcn);
+  omp_set_num_threads(4);
+  MnUserParameterState parallel = RunHesse(fcn);
+  omp_set_num_threads(nthreads);
+
+  if (serial.NFcn() != parallel.NFcn()) {
+     std::cerr << "number of function calls differs: serial " << serial.NFcn() << " parallel " << parallel.NFcn() << std::endl;
+     iret = 3;
+  }
+  for (unsigned int i = 0; i < 4; i++) {
+     for (unsigned int j = i; j < 4; j++) {
+        if (serial.Covariance()(i,j) != parallel.Covariance()(i,j)) {
+           std::cerr << "covariance differs at (" << i << "," << j << "): serial " << serial.Covariance()(i,j)
+                     << " parallel " << parallel.Covariance()(i,j) << std::endl;
+           iret = 4;
+        }
+     }
+  }
+#endif
+
+  return iret;
+}
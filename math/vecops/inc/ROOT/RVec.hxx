@@ -1218,6 +1218,260 @@ RVec<T> Where(const RVec<int>& c, T v1, T v2)
    return r;
 }
 
+/// Return the angle difference \f$\Delta \phi\f$ of two scalars.
+///
+/// The function computes the closest angle from v1 to v2 with sign and is
+/// therefore in the range \f$[-\pi, \pi]\f$.
+/// The computation is done per default in radians \f$c = \pi\f$ but can be switched
+/// to degrees \f$c = 180\f$.
+template <typename T>
+T DeltaPhi(T v1, T v2, const T c = 3.14159265358979323846)
+{
+   static_assert(std::is_floating_point<T>::value,
+                 "DeltaPhi must be called with floating point values.");
+   auto r = std::fmod(v2 - v1, 2 * c);
+   if (r < -c) {
+      r += 2 * c;
+   }
+   else if (r > c) {
+      r -= 2 * c;
+   }
+   return r;
+}
+
+/// Return the angle difference \f$\Delta \phi\f$ in radians of two vectors.
+///
+/// The function computes the closest angle from v1 to v2 with sign and is
+/// therefore in the range \f$[-\pi, \pi]\f$.
+/// The computation is done per default in radians \f$c = \pi\f$ but can be switched
+/// to degrees \f$c = 180\f$.
+template <typename T>
+RVec<T> DeltaPhi(const RVec<T>& v1, const RVec<T>& v2, const T c = 3.14159265358979323846)
+{
+   using size_type = typename RVec<T>::size_type;
+   const size_type size = v1.size();
+   if (v2.size() != size)
+      throw std::runtime_error("Cannot compute DeltaPhi of vectors of different sizes");
+   RVec<T> r(size);
+   for (size_type i = 0; i < size; i++) {
+      r[i] = DeltaPhi(v1[i], v2[i], c);
+   }
+   return r;
+}
+
+/// Return the angle difference \f$\Delta \phi\f$ in radians of a vector and a scalar.
+///
+/// The function computes the closest angle from v1 to v2 with sign and is
+/// therefore in the range \f$[-\pi, \pi]\f$.
+/// The computation is done per default in radians \f$c = \pi\f$ but can be switched
+/// to degrees \f$c = 180\f$.
+template <typename T>
+RVec<T> DeltaPhi(const RVec<T>& v1, T v2, const T c = 3.14159265358979323846)
+{
+   using size_type = typename RVec<T>::size_type;
+   const size_type size = v1.size();
+   RVec<T> r(size);
+   for (size_type i = 0; i < size; i++) {
+      r[i] = DeltaPhi(v1[i], v2, c);
+   }
+   return r;
+}
+
+/// Return the angle difference \f$\Delta \phi\f$ in radians of a scalar and a vector.
+///
+/// The function computes the closest angle from v1 to v2 with sign and is
+/// therefore in the range \f$[-\pi, \pi]\f$.
+/// The computation is done per default in radians \f$c = \pi\f$ but can be switched
+/// to degrees \f$c = 180\f$.
+template <typename T>
+RVec<T> DeltaPhi(T v1, const RVec<T>& v2, const T c = 3.14159265358979323846)
+{
+   using size_type = typename RVec<T>::size_type;
+   const size_type size = v2.size();
+   RVec<T> r(size);
+   for (size_type i = 0; i < size; i++) {
+      r[i] = DeltaPhi(v1, v2[i], c);
+   }
+   return r;
+}
+
+/// Return the square of the distance on the \f$\eta\f$-\f$\phi\f$ plane (\f$\Delta R\f$) from
+/// the collections eta1, eta2, phi1 and phi2.
+///
+/// The function computes \f$\Delta R^2 = (\eta_1 - \eta_2)^2 + (\phi_1 - \phi_2)^2\f$
+/// of the given collections eta1, eta2, phi1 and phi2. The angle \f$\phi\f$ can
+/// be set to radian or degrees using the optional argument c, see the documentation
+/// of the DeltaPhi helper.
+template <typename T>
+RVec<T> DeltaR2(const RVec<T>& eta1, const RVec<T>& eta2, const RVec<T>& phi1, const RVec<T>& phi2, const T c = 3.14159265358979323846)
+{
+   const auto dphi = DeltaPhi(phi1, phi2, c);
+   if (eta1.size() != eta2.size() || eta1.size() != dphi.size())
+      throw std::runtime_error("Cannot compute DeltaR2 of vectors of different sizes");
+   return (eta1 - eta2) * (eta1 - eta2) + dphi * dphi;
+}
+
+/// Return the distance on the \f$\eta\f$-\f$\phi\f$ plane (\f$\Delta R\f$) from
+/// the collections eta1, eta2, phi1 and phi2.
+///
+/// The function computes \f$\Delta R = \sqrt{(\eta_1 - \eta_2)^2 + (\phi_1 - \phi_2)^2}\f$
+/// of the given collections eta1, eta2, phi1 and phi2. The angle \f$\phi\f$ can
+/// be set to radian or degrees using the optional argument c, see the documentation
+/// of the DeltaPhi helper.
+template <typename T>
+RVec<T> DeltaR(const RVec<T>& eta1, const RVec<T>& eta2, const RVec<T>& phi1, const RVec<T>& phi2, const T c = 3.14159265358979323846)
+{
+   return sqrt(DeltaR2(eta1, eta2, phi1, phi2, c));
+}
+
+/// Return the distance on the \f$\eta\f$-\f$\phi\f$ plane (\f$\Delta R\f$) from
+/// the scalars eta1, eta2, phi1 and phi2.
+///
+/// The function computes \f$\Delta R = \sqrt{(\eta_1 - \eta_2)^2 + (\phi_1 - \phi_2)^2}\f$
+/// of the given scalars eta1, eta2, phi1 and phi2. The angle \f$\phi\f$ can
+/// be set to radian or degrees using the optional argument c, see the documentation
+/// of the DeltaPhi helper.
+template <typename T>
+T DeltaR(T eta1, T eta2, T phi1, T phi2, const T c = 3.14159265358979323846)
+{
+   const auto dphi = DeltaPhi(phi1, phi2, c);
+   return std::sqrt((eta1 - eta2) * (eta1 - eta2) + dphi * dphi);
+}
+
+/// Return the invariant mass of two particles given the collections of the
+/// quantities transverse momentum (pt), pseudorapidity (eta), azimuth (phi) and mass.
+///
+/// The function computes the invariant mass of two particles with the
+/// four-vectors (pt1, eta1, phi1, mass1) and (pt2, eta2, phi2, mass2), one
+/// entry of the returned collection per pair of input entries. No four-vector
+/// objects are created; the trigonometric functions are evaluated entry by
+/// entry with std::cos, std::sin and std::sinh.
+/// The result agrees with ROOT::Math::PtEtaPhiMVector::M() of the summed
+/// four-vectors whenever the sum is time-like.
+///
+/// Example code, at the ROOT prompt:
+/// ~~~{.cpp}
+/// using namespace ROOT::VecOps;
+/// RVec<double> pt {10., 20.}, eta {0.5, -1.}, phi {0., 3.}, mass {0.105, 0.105};
+/// auto m = InvariantMasses(pt, eta, phi, mass, pt, eta, -phi, mass);
+/// ~~~
+template <typename T>
+RVec<T> InvariantMasses(
+        const RVec<T>& pt1, const RVec<T>& eta1, const RVec<T>& phi1, const RVec<T>& mass1,
+        const RVec<T>& pt2, const RVec<T>& eta2, const RVec<T>& phi2, const RVec<T>& mass2)
+{
+   using size_type = typename RVec<T>::size_type;
+   const size_type size = pt1.size();
+   if (eta1.size() != size || phi1.size() != size || mass1.size() != size ||
+       pt2.size() != size || eta2.size() != size || phi2.size() != size || mass2.size() != size)
+      throw std::runtime_error("Cannot compute InvariantMasses of vectors of different sizes");
+
+   RVec<T> inv_masses(size);
+
+   for (size_type i = 0; i < size; i++) {
+      // Conversion from (pt, eta, phi, mass) to (x, y, z, e) coordinate system
+      const auto x1 = pt1[i] * std::cos(phi1[i]);
+      const auto y1 = pt1[i] * std::sin(phi1[i]);
+      const auto z1 = pt1[i] * std::sinh(eta1[i]);
+      const auto e1 = std::sqrt(x1 * x1 + y1 * y1 + z1 * z1 + mass1[i] * mass1[i]);
+
+      const auto x2 = pt2[i] * std::cos(phi2[i]);
+      const auto y2 = pt2[i] * std::sin(phi2[i]);
+      const auto z2 = pt2[i] * std::sinh(eta2[i]);
+      const auto e2 = std::sqrt(x2 * x2 + y2 * y2 + z2 * z2 + mass2[i] * mass2[i]);
+
+      // Addition of particle four-vectors
+      const auto e = e1 + e2;
+      const auto x = x1 + x2;
+      const auto y = y1 + y2;
+      const auto z = z1 + z2;
+
+      // Return invariant mass with (+, -, -, -) metric
+      inv_masses[i] = std::sqrt(e * e - x * x - y * y - z * z);
+   }
+
+   return inv_masses;
+}
+
+/// Return the invariant mass of multiple particles given the collections of the
+/// quantities transverse momentum (pt), pseudorapidity (eta), azimuth (phi) and mass.
+///
+/// The function computes the invariant mass of multiple particles with the
+/// four-vectors (pt, eta, phi, mass).
+///
+/// Example code, at the ROOT prompt:
+/// ~~~{.cpp}
+/// using namespace ROOT::VecOps;
+/// RVec<double> pt {10., 20., 30.}, eta {0.5, -1., 2.}, phi {0., 3., -2.}, mass {0.105, 0.105, 0.105};
+/// auto m = InvariantMass(pt, eta, phi, mass);
+/// ~~~
+template <typename T>
+T InvariantMass(const RVec<T>& pt, const RVec<T>& eta, const RVec<T>& phi, const RVec<T>& mass)
+{
+   using size_type = typename RVec<T>::size_type;
+   const size_type size = pt.size();
+   if (eta.size() != size || phi.size() != size || mass.size() != size)
+      throw std::runtime_error("Cannot compute InvariantMass of vectors of different sizes");
+
+   // Sum the four-vectors in the (x, y, z, e) coordinate system
+   T x_sum = 0.;
+   T y_sum = 0.;
+   T z_sum = 0.;
+   T e_sum = 0.;
+   for (size_type i = 0; i < size; i++) {
+      const auto x = pt[i] * std::cos(phi[i]);
+      const auto y = pt[i] * std::sin(phi[i]);
+      const auto z = pt[i] * std::sinh(eta[i]);
+      x_sum += x;
+      y_sum += y;
+      z_sum += z;
+      e_sum += std::sqrt(x * x + y * y + z * z + mass[i] * mass[i]);
+   }
+
+   // Return invariant mass with (+, -, -, -) metric
+   return std::sqrt(e_sum * e_sum - x_sum * x_sum - y_sum * y_sum - z_sum * z_sum);
+}
+
+/// Build an RVec of objects starting from RVecs of input to their constructors.
+/// \tparam T Type of the objects contained in the created RVec.
+/// \tparam Args_t Pack of types templating the input RVecs.
+/// \param[in] args The RVecs containing the values used to initialise the output objects.
+/// \return The RVec of objects initialised with the input parameters.
+///
+/// This turns structure-of-arrays data, e.g. the coordinates of the particles
+/// of an event, into a collection of objects, e.g. four-vectors, on which
+/// the GenVector interface can be used. One object is created per entry and
+/// operations such as boosts are then applied object by object; GenVector and
+/// SMatrix have no batched or SIMD evaluation over such collections.
+///
+/// Example code, at the ROOT prompt:
+/// ~~~{.cpp}
+/// using namespace ROOT::VecOps;
+/// RVec<float> pts = {15.5, 34.32, 12.95};
+/// RVec<float> etas = {0.3, 2.2, 1.32};
+/// RVec<float> phis = {0.1, 3.02, 2.2};
+/// RVec<float> masses = {105.65, 105.65, 105.65};
+/// auto fourVecs = Construct<ROOT::Math::PtEtaPhiMVector>(pts, etas, phis, masses);
+/// auto boosted = Map(fourVecs, [](const ROOT::Math::PtEtaPhiMVector &v) { return ROOT::Math::VectorUtil::boostX(v, 0.5); });
+/// ~~~
+template <typename T, typename... Args_t>
+RVec<T> Construct(const RVec<Args_t> &... args)
+{
+   static_assert(sizeof...(Args_t) > 0, "Construct must be called with at least one RVec.");
+   const std::size_t sizes[] = {args.size()...};
+   const auto size = sizes[0];
+   for (auto s : sizes) {
+      if (s != size)
+         throw std::runtime_error("Cannot construct objects from vectors of different sizes");
+   }
+   RVec<T> ret;
+   ret.reserve(size);
+   for (std::size_t i = 0; i < size; i++) {
+      ret.emplace_back(args[i]...);
+   }
+   return ret;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Print a RVec at the prompt:
 template <class T>
@@ -1,4 +1,5 @@
 #include <gtest/gtest.h>
+#include <Math/Vector4D.h>
 #include <ROOT/RVec.hxx>
 #include <ROOT/TSeq.hxx>
 #include <TFile.h>
@@ -850,3 +851,120 @@ TEST(VecOps, Where)
    RVec<float> ref4{1, -1, 1, -1};
    CheckEqual(v6, ref4);
 }
+
+TEST(VecOps, DeltaPhi)
+{
+   // Two scalars (radians)
+   // NOTE: These tests include the checks of the poles and the 2pi bound
+   const double c1 = M_PI;
+   EXPECT_EQ(DeltaPhi(0.0, 1.0), 1.0);
+   EXPECT_EQ(DeltaPhi(1.0, 0.0), -1.0);
+   EXPECT_EQ(DeltaPhi(-0.5, 0.5), 1.0);
+   EXPECT_EQ(DeltaPhi(0.5, -0.5), -1.0);
+   EXPECT_NEAR(DeltaPhi(0.0, 2.0 * c1 - 1.0), -1.0, 1e-12);
+   EXPECT_NEAR(DeltaPhi(0.0, 2.0 * c1 + 1.0), 1.0, 1e-12);
+
+   // Two scalars (degrees)
+   const float c2 = 180.f;
+   EXPECT_EQ(DeltaPhi(0.f, 1.f, c2), 1.f);
+   EXPECT_EQ(DeltaPhi(1.f, 0.f, c2), -1.f);
+   EXPECT_EQ(DeltaPhi(0.f, 2.f * c2 - 1.f, c2), -1.f);
+   EXPECT_EQ(DeltaPhi(0.f, 2.f * c2 + 1.f, c2), 1.f);
+
+   // Two vectors
+   RVec<float> v1 = {0.0, 1.0, -0.5, 0.5};
+   RVec<float> v2 = {1.0, 0.0, 0.5, -0.5};
+   auto dphi1 = DeltaPhi(v1, v2);
+   RVec<float> r1 = {1.0, -1.0, 1.0, -1.0};
+   CheckEqual(dphi1, r1);
+
+   // Check against the scalar helper
+   auto dphi2 = DeltaPhi(v2, v1);
+   for (std::size_t i = 0; i < v1.size(); i++)
+      EXPECT_EQ(dphi2[i], DeltaPhi(v2[i], v1[i]));
+
+   // Vector and scalar
+   auto dphi3 = DeltaPhi(v1, 0.f);
+   auto dphi4 = DeltaPhi(0.f, v1);
+   for (std::size_t i = 0; i < v1.size(); i++) {
+      EXPECT_EQ(dphi3[i], DeltaPhi(v1[i], 0.f));
+      EXPECT_EQ(dphi4[i], DeltaPhi(0.f, v1[i]));
+   }
+
+   // Vectors of different sizes
+   RVec<float> v3 = {0.0, 1.0};
+   EXPECT_THROW(DeltaPhi(v1, v3), std::runtime_error);
+}
+
+TEST(VecOps, DeltaR)
+{
+   RVec<double> eta1 = {0.1, -1.0, 2.5};
+   RVec<double> eta2 = {0.3, 1.0, -0.5};
+   RVec<double> phi1 = {1.0, 3.0, -3.0};
+   RVec<double> phi2 = {-1.0, -3.0, 0.2};
+
+   auto dr = DeltaR(eta1, eta2, phi1, phi2);
+   auto dr2 = DeltaR2(eta1, eta2, phi1, phi2);
+   for (std::size_t i = 0; i < eta1.size(); i++) {
+      const auto ref = DeltaR(eta1[i], eta2[i], phi1[i], phi2[i]);
+      EXPECT_DOUBLE_EQ(dr[i], ref);
+      EXPECT_DOUBLE_EQ(dr2[i], ref * ref);
+   }
+   // The phi difference wraps around at pi
+   EXPECT_NEAR(DeltaR(0., 0., 3., -3.), 2. * M_PI - 6., 1e-12);
+}
+
+TEST(VecOps, InvariantMass)
+{
+   // Dummy particle collections
+   RVec<double> mass1 = {50, 50, 50, 50, 50};
+   RVec<double> pt1 = {0, 5, 5, 10, 10};
+   RVec<double> eta1 = {0.0, 0.0, -1.0, 0.5, 2.5};
+   RVec<double> phi1 = {0.0, 0.0, 0.0, -0.5, -2.4};
+
+   RVec<double> mass2 = {40, 40, 40, 40, 30};
+   RVec<double> pt2 = {0, 5, 5, 10, 2};
+   RVec<double> eta2 = {0.0, 0.0, 0.5, 0.4, 1.2};
+   RVec<double> phi2 = {0.0, 0.0, 0.0, 0.5, 2.4};
+
+   // Compute invariant mass of two particle system using both collections
+   const auto invMass = InvariantMasses(pt1, eta1, phi1, mass1, pt2, eta2, phi2, mass2);
+
+   for (std::size_t i = 0; i < mass1.size(); i++) {
+      ROOT::Math::PtEtaPhiMVector p1(pt1[i], eta1[i], phi1[i], mass1[i]);
+      ROOT::Math::PtEtaPhiMVector p2(pt2[i], eta2[i], phi2[i], mass2[i]);
+      // GenVector sums the vectors in a different coordinate system
+      EXPECT_NEAR((p1 + p2).M(), invMass[i], 1e-4);
+   }
+
+   // Compute invariant mass of multiple-particle system using a single collection
+   const auto invMass2 = InvariantMass(pt1, eta1, phi1, mass1);
+
+   ROOT::Math::PtEtaPhiMVector p3;
+   for (std::size_t i = 0; i < mass1.size(); i++) {
+      p3 += ROOT::Math::PtEtaPhiMVector(pt1[i], eta1[i], phi1[i], mass1[i]);
+   }
+   EXPECT_NEAR(p3.M(), invMass2, 1e-4);
+
+   // Collections of different sizes
+   RVec<double> pt3 = {0, 5};
+   EXPECT_THROW(InvariantMasses(pt3, eta1, phi1, mass1, pt2, eta2, phi2, mass2), std::runtime_error);
+   EXPECT_THROW(InvariantMass(pt3, eta1, phi1, mass1), std::runtime_error);
+}
+
+TEST(VecOps, Construct)
+{
+   RVec<float> pts {15.5, 34.32, 12.95};
+   RVec<float> etas {0.3, 2.2, 1.32};
+   RVec<float> phis {0.1, 3.02, 2.2};
+   RVec<float> masses {105.65, 105.65, 105.65};
+   auto fourVects = Construct<ROOT::Math::PtEtaPhiMVector>(pts, etas, phis, masses);
+   ASSERT_EQ(fourVects.size(), 3u);
+   for (std::size_t i = 0; i < pts.size(); i++) {
+      const ROOT::Math::PtEtaPhiMVector ref(pts[i], etas[i], phis[i], masses[i]);
+      EXPECT_TRUE(fourVects[i] == ref);
+   }
+
+   RVec<float> etas2 {0.3, 2.2};
+   EXPECT_THROW(Construct<ROOT::Math::PtEtaPhiMVector>(pts, etas2, phis, masses), std::runtime_error);
+}
@@ -56,9 +56,13 @@ namespace HistFactory{
     virtual void printMultiline(std::ostream& os, Int_t contents, Bool_t verbose = kFALSE, TString indent = "") const;
     virtual void printFlexibleInterpVars(std::ostream& os) const;
 
+    virtual Bool_t hasAnalyticalDerivative(const RooAbsArg& param, const RooArgSet* normSet=0) const ;
+    virtual Double_t analyticalDerivative(const RooAbsArg& param, const RooArgSet* normSet=0) const ;
+
   private:
 
     double PolyInterpValue(int i, double x) const;
+    double PolyInterpDerivative(int i, double x) const;
 
   protected:
 
@@ -59,6 +59,9 @@ public:
   virtual std::list<Double_t>* plotSamplingHint(RooAbsRealLValue& obs, Double_t xlo, Double_t xhi) const ; 
   virtual Bool_t isBinnedDistribution(const RooArgSet& obs) const ;
 
+  virtual Bool_t hasAnalyticalDerivative(const RooAbsArg& param, const RooArgSet* normSet=0) const ;
+  virtual Double_t analyticalDerivative(const RooAbsArg& param, const RooArgSet* normSet=0) const ;
+
 protected:
 
   class CacheElem : public RooAbsCacheElement {
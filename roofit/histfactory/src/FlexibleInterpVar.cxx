@@ -377,6 +377,128 @@ double FlexibleInterpVar::PolyInterpValue(int i, double x) const {
    return value; 
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Derivative of the polynomial used for interpCode=4 with respect to x
+
+double FlexibleInterpVar::PolyInterpDerivative(int i, double x) const {
+   // make sure the polynomial coefficients are cached
+   if (!_logInit) PolyInterpValue(i, x);
+
+   const double * coefficients = &_polCoeff.front() + 6*i;
+   double a = coefficients[0];
+   double b = coefficients[1];
+   double c = coefficients[2];
+   double d = coefficients[3];
+   double e = coefficients[4];
+   double f = coefficients[5];
+
+   return a + x * ( 2*b + x * ( 3*c + x * ( 4*d + x * ( 5*e + x * 6*f ) ) ) );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// The derivative is available if all interpolation parameters have an
+/// analytical derivative and use one of the known interpolation codes
+
+Bool_t FlexibleInterpVar::hasAnalyticalDerivative(const RooAbsArg& param, const RooArgSet* normSet) const
+{
+  if (!dependsOnValue(param)) return kTRUE ;
+
+  RooFIter paramIter = _paramList.fwdIterator() ;
+  RooAbsReal* p ;
+  int i=0;
+  while((p=(RooAbsReal*)paramIter.next())) {
+    if (_interpCode[i]<0 || _interpCode[i]>4) return kFALSE ;
+    if (!p->hasAnalyticalDerivative(param,normSet)) return kFALSE ;
+    ++i;
+  }
+  return kTRUE ;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the derivative of evaluate() with respect to param. The additive and
+/// multiplicative interpolation steps are applied in the same order as in
+/// evaluate(), propagating the running value and its derivative.
+
+Double_t FlexibleInterpVar::analyticalDerivative(const RooAbsArg& param, const RooArgSet* normSet) const
+{
+  if (!dependsOnValue(param)) return 0 ;
+
+  Double_t total(_nominal), deriv(0) ;
+  RooFIter paramIter = _paramList.fwdIterator() ;
+  RooAbsReal* p ;
+  int i=0;
+  while((p=(RooAbsReal*)paramIter.next())) {
+    double x = p->getVal() ;
+    double dx = p->analyticalDerivative(param,normSet) ;
+
+    // Multiplicative factor and its derivative with respect to x, if any
+    double mult(1), dmult(0) ;
+    bool isMult(false) ;
+
+    switch(_interpCode[i]) {
+    case 0: {
+      double slope = (x>0) ? (_high[i] - _nominal) : (_nominal - _low[i]) ;
+      total += x*slope ;
+      deriv += dx*slope ;
+      break ;
+    }
+    case 1: {
+      isMult = true ;
+      if (x>=0) {
+        mult = pow(_high[i]/_nominal, +x) ;
+        dmult = mult*log(_high[i]/_nominal) ;
+      } else {
+        mult = pow(_low[i]/_nominal, -x) ;
+        dmult = -mult*log(_low[i]/_nominal) ;
+      }
+      break ;
+    }
+    case 2:
+    case 3: {
+      double a = 0.5*(_high[i]+_low[i])-_nominal;
+      double b = 0.5*(_high[i]-_low[i]);
+      if (x>1) {
+        total += (2*a+b)*(x-1)+_high[i]-_nominal;
+        deriv += dx*(2*a+b) ;
+      } else if (x<-1) {
+        total += -1*(2*a-b)*(x+1)+_low[i]-_nominal;
+        deriv += -dx*(2*a-b) ;
+      } else {
+        total += a*x*x + b*x ;
+        deriv += dx*(2*a*x + b) ;
+      }
+      break ;
+    }
+    case 4: {
+      isMult = true ;
+      double boundary = _interpBoundary;
+      if (x >= boundary) {
+        mult = std::pow(_high[i]/_nominal, +x) ;
+        dmult = mult*std::log(_high[i]/_nominal) ;
+      } else if (x <= -boundary) {
+        mult = std::pow(_low[i]/_nominal, -x) ;
+        dmult = -mult*std::log(_low[i]/_nominal) ;
+      } else {
+        if (x != 0) mult = PolyInterpValue(i, x) ;
+        dmult = PolyInterpDerivative(i, x) ;
+      }
+      break ;
+    }
+    }
+
+    if (isMult) {
+      deriv = deriv*mult + total*dmult*dx ;
+      total *= mult ;
+    }
+    ++i;
+  }
+
+  // evaluate() clamps non-positive results to a constant
+  if (total<=0) return 0 ;
+
+  return deriv ;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Calculate and return value of polynomial
 
@@ -307,6 +307,149 @@ Double_t PiecewiseInterpolation::evaluate() const
 
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// The derivative is available with respect to parameters that only enter
+/// through the interpolation parameters, i.e. not through the nominal or
+/// the variation shapes, for all known interpolation codes
+
+Bool_t PiecewiseInterpolation::hasAnalyticalDerivative(const RooAbsArg& param, const RooArgSet* normSet) const
+{
+  if (!dependsOnValue(param)) return kTRUE ;
+  if (_nominal.arg().dependsOnValue(param)) return kFALSE ;
+
+  RooFIter lowIter(_lowSet.fwdIterator()) ;
+  RooFIter highIter(_highSet.fwdIterator()) ;
+  RooFIter paramIter(_paramSet.fwdIterator()) ;
+  RooAbsReal* p ;
+  int i=0;
+  while((p=(RooAbsReal*)paramIter.next())) {
+    if (lowIter.next()->dependsOnValue(param) || highIter.next()->dependsOnValue(param)) return kFALSE ;
+    if (_interpCode[i]<0 || _interpCode[i]>5) return kFALSE ;
+    if (!p->hasAnalyticalDerivative(param,normSet)) return kFALSE ;
+    ++i;
+  }
+  return kTRUE ;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the derivative of evaluate() with respect to param, following the
+/// additive and multiplicative interpolation steps in the order of evaluate()
+
+Double_t PiecewiseInterpolation::analyticalDerivative(const RooAbsArg& param, const RooArgSet* normSet) const
+{
+  if (!dependsOnValue(param)) return 0 ;
+
+  Double_t nominal = _nominal;
+  Double_t sum(nominal), deriv(0) ;
+
+  RooAbsReal* p ;
+  RooAbsReal* high ;
+  RooAbsReal* low ;
+  int i=0;
+
+  RooFIter lowIter(_lowSet.fwdIterator()) ;
+  RooFIter highIter(_highSet.fwdIterator()) ;
+  RooFIter paramIter(_paramSet.fwdIterator()) ;
+
+  while((p=(RooAbsReal*)paramIter.next())) {
+    low = (RooAbsReal*)lowIter.next() ;
+    high = (RooAbsReal*)highIter.next() ;
+
+    double x = p->getVal() ;
+    double dx = p->analyticalDerivative(param,normSet) ;
+
+    switch(_interpCode[i]) {
+    case 0: {
+      double slope = (x>0) ? (high->getVal() - nominal) : (nominal - low->getVal()) ;
+      sum += x*slope ;
+      deriv += dx*slope ;
+      break ;
+    }
+    case 1: {
+      double mult, dmult ;
+      if (x>=0) {
+        mult = pow(high->getVal()/nominal, +x) ;
+        dmult = mult*log(high->getVal()/nominal) ;
+      } else {
+        mult = pow(low->getVal()/nominal, -x) ;
+        dmult = -mult*log(low->getVal()/nominal) ;
+      }
+      deriv = deriv*mult + sum*dmult*dx ;
+      sum *= mult ;
+      break ;
+    }
+    case 2:
+    case 3: {
+      double a = 0.5*(high->getVal()+low->getVal())-nominal;
+      double b = 0.5*(high->getVal()-low->getVal());
+      if (x>1) {
+        sum += (2*a+b)*(x-1)+high->getVal()-nominal;
+        deriv += dx*(2*a+b) ;
+      } else if (x<-1) {
+        sum += -1*(2*a-b)*(x+1)+low->getVal()-nominal;
+        deriv += -dx*(2*a-b) ;
+      } else {
+        sum += a*x*x + b*x ;
+        deriv += dx*(2*a*x + b) ;
+      }
+      break ;
+    }
+    case 4: {
+      if (x>1) {
+        sum += x*(high->getVal() - nominal) ;
+        deriv += dx*(high->getVal() - nominal) ;
+      } else if (x<-1) {
+        sum += x*(nominal - low->getVal()) ;
+        deriv += dx*(nominal - low->getVal()) ;
+      } else {
+        double eps_plus = high->getVal() - nominal;
+        double eps_minus = nominal - low->getVal();
+        double S = 0.5 * (eps_plus + eps_minus);
+        double A = 0.0625 * (eps_plus - eps_minus);
+        double val = nominal + x * (S + x * A * ( 15 + x * x * (-10 + x * x * 3  ) ) );
+        if (val < 0) {
+          sum -= nominal ;
+        } else {
+          sum += val-nominal ;
+          deriv += dx*(S + x * A * ( 30 + x * x * (-40 + x * x * 18 ) ) ) ;
+        }
+      }
+      break ;
+    }
+    case 5: {
+      double x0 = 1.0;
+      if (x > x0 || x < -x0) {
+        double slope = (x>0) ? (high->getVal() - nominal) : (nominal - low->getVal()) ;
+        sum += x*slope ;
+        deriv += dx*slope ;
+      } else if (nominal != 0) {
+        double eps_plus = high->getVal() - nominal;
+        double eps_minus = nominal - low->getVal();
+        double S = (eps_plus + eps_minus)/2;
+        double A = (eps_plus - eps_minus)/2;
+        double a = S;
+        double b = 3*A/(2*x0);
+        double d = -A/(2*x0*x0*x0);
+        double val = nominal + a*x + b*pow(x, 2) + d*pow(x, 4);
+        if (val < 0) {
+          sum -= nominal ;
+        } else {
+          sum += val-nominal ;
+          deriv += dx*(a + 2*b*x + 4*d*pow(x, 3)) ;
+        }
+      }
+      break ;
+    }
+    }
+    ++i;
+  }
+
+  // evaluate() clips negative sums to zero for positive definite interpolations
+  if (_positiveDefinite && (sum<0)) return 0 ;
+
+  return deriv ;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 Bool_t PiecewiseInterpolation::setBinIntegrator(RooArgSet& allVars) 
@@ -614,6 +757,8 @@ void PiecewiseInterpolation::setInterpCode(RooAbsReal& param, int code){
 			    << " is now " << code << endl ;
     _interpCode.at(index) = code;
   }
+  // The interpolation changes the shape of the function in the observables
+  setShapeDirty();
 }
 
 
@@ -623,6 +768,7 @@ void PiecewiseInterpolation::setAllInterpCodes(int code){
   for(unsigned int i=0; i<_interpCode.size(); ++i){
     _interpCode.at(i) = code;
   }
+  setShapeDirty();
 }
 
 
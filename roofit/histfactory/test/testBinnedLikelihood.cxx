@@ -0,0 +1,99 @@
+#include <RooStats/HistFactory/PiecewiseInterpolation.h>
+#include <RooStats/HistFactory/FlexibleInterpVar.h>
+#include <RooNLLVar.h>
+#include <RooRealVar.h>
+#include <RooDataHist.h>
+#include <RooHistFunc.h>
+#include <RooProduct.h>
+#include <RooRealSumPdf.h>
+#include <RooArgSet.h>
+#include <RooArgList.h>
+#include <RooMsgService.h>
+
+#include <TMath.h>
+
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using RooStats::HistFactory::FlexibleInterpVar;
+
+
+// Binned likelihood calculated directly from the p.d.f. values in each bin of the data
+static Double_t BinnedNLL(RooAbsPdf& pdf, RooRealVar& x, RooDataHist& data)
+{
+   Double_t result(0);
+   for (Int_t i = 0; i < data.numEntries(); ++i) {
+      x.setVal(data.get(i)->getRealValue(x.GetName()));
+      const Double_t N = data.weight();
+      const Double_t mu = pdf.getVal() * data.binVolume();
+      if (std::abs(mu) < 1e-10 && std::abs(N) < 1e-10) continue;
+      result -= -mu + N * std::log(mu) - TMath::LnGamma(N + 1);
+   }
+   return result;
+}
+
+// Changing the interpolation codes of the likelihood's model invalidates its cached component values
+TEST(BinnedLikelihood, InterpolationCodes)
+{
+   RooMsgService::instance().setGlobalKillBelow(RooFit::ERROR);
+
+   RooRealVar x("x", "x", 0, 10);
+   x.setBins(10);
+
+   RooDataHist nomHist("nomHist", "nomHist", RooArgSet(x));
+   RooDataHist lowHist("lowHist", "lowHist", RooArgSet(x));
+   RooDataHist highHist("highHist", "highHist", RooArgSet(x));
+   RooDataHist data("data", "data", RooArgSet(x));
+   for (Int_t i = 0; i < 10; ++i) {
+      const Double_t nom = 20. - i;
+      nomHist.get(i);
+      nomHist.set(nom);
+      lowHist.get(i);
+      lowHist.set(nom * (0.8 + 0.01 * i));
+      highHist.get(i);
+      highHist.set(nom * (1.3 - 0.02 * i));
+      data.get(i);
+      data.set(nom + 3. - (i % 4));
+   }
+
+   RooHistFunc nominal("nominal", "nominal", RooArgSet(x), nomHist);
+   RooHistFunc low("low", "low", RooArgSet(x), lowHist);
+   RooHistFunc high("high", "high", RooArgSet(x), highHist);
+   RooRealVar alpha("alpha", "alpha", 0.6, -5, 5);
+   PiecewiseInterpolation shape("shape", "shape", nominal, RooArgList(low), RooArgList(high), RooArgList(alpha));
+
+   RooRealVar beta("beta", "beta", 0.4, -5, 5);
+   FlexibleInterpVar norm("norm", "norm", RooArgList(beta), 1., std::vector<double>{0.9}, std::vector<double>{1.2});
+
+   RooProduct sample("sample", "sample", RooArgList(shape, norm));
+   RooRealVar mu("mu", "mu", 1.5, 0, 10);
+
+   RooRealSumPdf model("model", "model", RooArgList(sample), RooArgList(mu), kTRUE);
+   model.setAttribute("BinnedLikelihood");
+
+   RooNLLVar nll("nll", "nll", model, data, kFALSE, 0, 0, 1, RooFit::BulkPartition, kFALSE, kFALSE, kTRUE, kTRUE);
+   std::unique_ptr<RooArgSet> comps(nll.function().getComponents());
+   auto shapeClone = dynamic_cast<PiecewiseInterpolation*>(comps->find("shape"));
+   auto normClone = dynamic_cast<FlexibleInterpVar*>(comps->find("norm"));
+   ASSERT_TRUE(shapeClone && normClone);
+
+   EXPECT_NEAR(nll.getVal(), BinnedNLL(model, x, data), 1e-9);
+
+   // Interpolation code of an observable-dependent component
+   shape.setAllInterpCodes(4);
+   shapeClone->setAllInterpCodes(4);
+   nll.setValueDirty();
+   EXPECT_NEAR(nll.getVal(), BinnedNLL(model, x, data), 1e-9);
+
+   // Interpolation code of a parameter-dependent factor of the component
+   norm.setAllInterpCodes(1);
+   normClone->setAllInterpCodes(1);
+   nll.setValueDirty();
+   EXPECT_NEAR(nll.getVal(), BinnedNLL(model, x, data), 1e-9);
+
+   alpha.setVal(-0.7);
+   EXPECT_NEAR(nll.getVal(), BinnedNLL(model, x, data), 1e-9);
+}
@@ -39,6 +39,9 @@ public:
 
   Double_t getLogVal(const RooArgSet* set) const ;
 
+  Bool_t hasAnalyticalDerivative(const RooAbsArg& param, const RooArgSet* normSet=0) const ;
+  Double_t analyticalDerivative(const RooAbsArg& param, const RooArgSet* normSet=0) const ;
+
 protected:
 
   RooRealProxy x ;
@@ -49,6 +52,8 @@ protected:
 
 private:
 
+  Int_t derivativeNormCode(const RooArgSet* nset) const ;
+
   ClassDef(RooGaussian,1) // Gaussian PDF
 };
 
@@ -31,6 +31,7 @@ Plain Gaussian p.d.f
 #include "RooRealVar.h"
 #include "RooRandom.h"
 #include "RooMath.h"
+#include "RooNumber.h"
 
 using namespace std;
 
@@ -122,6 +123,85 @@ Double_t RooGaussian::analyticalIntegral(Int_t code, const char* rangeName) cons
 
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return the analytical integration code that normalizes getVal(nset):
+/// 0 if no normalization is applied, 1 or 2 for normalization over x or mean
+/// and -1 if the normalization is not covered by analyticalIntegral()
+
+Int_t RooGaussian::derivativeNormCode(const RooArgSet* nset) const
+{
+  if (!nset) return 0 ;
+  Bool_t hasX = nset->contains(x.arg()) ;
+  Bool_t hasMean = nset->contains(mean.arg()) ;
+  if (nset->contains(sigma.arg()) || (hasX && hasMean)) return -1 ;
+  if (hasX) return dynamic_cast<const RooAbsRealLValue*>(&x.arg()) ? 1 : -1 ;
+  if (hasMean) return dynamic_cast<const RooAbsRealLValue*>(&mean.arg()) ? 2 : -1 ;
+  return 0 ;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// The derivative is available if the normalization over nset is one of
+/// the analytical integrals and x, mean and sigma have analytical derivatives
+
+Bool_t RooGaussian::hasAnalyticalDerivative(const RooAbsArg& param, const RooArgSet* nset) const
+{
+  if (!dependsOnValue(param)) return kTRUE ;
+  Int_t code = derivativeNormCode(nset) ;
+  if (code<0) return kFALSE ;
+  if (nset) {
+    // The normalization may only involve the variable covered by the analytical integral
+    RooArgSet* deps = getObservables(nset) ;
+    Int_t ndeps = deps->getSize() ;
+    delete deps ;
+    if (ndeps != (code==0 ? 0 : 1)) return kFALSE ;
+  }
+  return x.arg().hasAnalyticalDerivative(param,nset) && mean.arg().hasAnalyticalDerivative(param,nset) &&
+         sigma.arg().hasAnalyticalDerivative(param,nset) ;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the derivative of getVal(nset) with respect to param. For the normalized
+/// Gaussian N = Int[lo,hi] exp(-0.5*(v-c)^2/sigma^2) dv, where v is the normalized
+/// variable and c the other one of x and mean, the derivatives of the integral are
+/// dN/dc = g(lo)-g(hi) and dN/dsigma = N/sigma - ((hi-c)*g(hi)-(lo-c)*g(lo))/sigma
+
+Double_t RooGaussian::analyticalDerivative(const RooAbsArg& param, const RooArgSet* nset) const
+{
+  if (!dependsOnValue(param)) return 0 ;
+
+  Double_t dx = x.arg().analyticalDerivative(param,nset) ;
+  Double_t dmean = mean.arg().analyticalDerivative(param,nset) ;
+  Double_t dsig = sigma.arg().analyticalDerivative(param,nset) ;
+
+  Double_t arg = x - mean ;
+  Double_t sig = sigma ;
+  Double_t val = exp(-0.5*arg*arg/(sig*sig)) ;
+  Double_t dval = val*(-arg*(dx-dmean)/(sig*sig) + arg*arg*dsig/(sig*sig*sig)) ;
+
+  Int_t code = derivativeNormCode(nset) ;
+  if (code==0) return dval ;
+
+  const char* rangeName = _normRangeOverride.Length()>0 ? _normRangeOverride.Data() : normRange() ;
+  Double_t norm = analyticalIntegral(code,rangeName) ;
+  Double_t lo = (code==1) ? x.min(rangeName) : mean.min(rangeName) ;
+  Double_t hi = (code==1) ? x.max(rangeName) : mean.max(rangeName) ;
+  Double_t c = (code==1) ? mean : x ;
+  Double_t dc = (code==1) ? dmean : dx ;
+
+  Double_t glo(0), ghi(0), tlo(0), thi(0) ;
+  if (!RooNumber::isInfinite(lo)) {
+    glo = exp(-0.5*(lo-c)*(lo-c)/(sig*sig)) ;
+    tlo = (lo-c)*glo ;
+  }
+  if (!RooNumber::isInfinite(hi)) {
+    ghi = exp(-0.5*(hi-c)*(hi-c)/(sig*sig)) ;
+    thi = (hi-c)*ghi ;
+  }
+  Double_t dnorm = (glo-ghi)*dc + (norm - (thi-tlo))*dsig/sig ;
+
+  return (dval*norm - val*dnorm)/(norm*norm) ;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 Int_t RooGaussian::getGenerator(const RooArgSet& directVars, RooArgSet &generateVars, Bool_t /*staticInitOK*/) const
@@ -16,7 +16,7 @@
 #pragma link C++ class RooErrorVar+ ;
 #pragma link C++ class RooFitResult- ;
 #pragma link C++ class RooFIter+ ;
-#pragma link C++ class RooFormula+ ;
+#pragma link C++ class RooFormula- ;
 #pragma link C++ class RooFormulaVar+ ;
 #pragma link C++ class RooGaussKronrodIntegrator1D+ ;
 #pragma link C++ class RooGenContext+ ;
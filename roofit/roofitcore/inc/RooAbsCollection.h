@@ -58,6 +58,11 @@ public:
     // Return size of internal hash table
     return _list.getHashTableSize() ; 
   }
+  static void setDefaultHashThreshold(Int_t thresh) ;
+  static Int_t defaultHashThreshold() { 
+    // Return collection size above which name lookups switch to a hash table
+    return _defaultHashThresh ; 
+  }
 
   // List content management
   virtual Bool_t add(const RooAbsArg& var, Bool_t silent=kFALSE) ;
@@ -169,6 +174,8 @@ protected:
   TString _name;    // Our name.
   Bool_t _allRRV ; // All contents are RRV
 
+  static Int_t _defaultHashThresh ; // Size above which new collections automatically hash their contents
+
   void safeDeleteList() ;
 
   // Support for snapshot method 
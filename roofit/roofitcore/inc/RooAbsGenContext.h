@@ -67,6 +67,7 @@ public:
 
   virtual void generateEvent(RooArgSet &theEvent, Int_t remaining) = 0;
   virtual void initGenerator(const RooArgSet &theEvent);
+  void initialize() ;
 
 protected:
 
@@ -72,6 +72,7 @@ protected:
   virtual RooArgSet requiredExtraObservables() const { return RooArgSet() ; }
   void optimizeCaching() ;
   void optimizeConstantTerms(Bool_t,Bool_t=kTRUE) ;
+  void foldConstantNodes(Bool_t) ;
 
   RooArgSet*  _normSet ; // Pointer to set with observables used for normalization
   RooArgSet*  _funcCloneSet ; // Set owning all components of internal clone of input function
@@ -83,6 +84,7 @@ protected:
   TString     _sealNotice ; // User-defined notice shown when reading a sealed likelihood 
   RooArgSet*  _funcObsSet ; // List of observables in the pdf expression
   RooArgSet   _cachedNodes ; //! List of nodes that are cached as constant expressions
+  RooArgSet   _foldedNodes ; //! List of observable-independent constant expressions frozen at their value
   
   RooAbsReal* _origFunc ; // Original function 
   RooAbsData* _origData ; // Original data 
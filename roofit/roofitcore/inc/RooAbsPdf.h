@@ -279,6 +279,8 @@ protected:
   RooDataSet *generate(RooAbsGenContext& context, const RooArgSet& whatVars, const RooDataSet* prototype,
 		       Double_t nEvents, Bool_t verbose, Bool_t randProtoOrder, Bool_t resampleProto, Bool_t skipInit=kFALSE, 
 		       Bool_t extended=kFALSE) const ;
+  RooDataSet *generateParallel(const RooArgSet &whatVars, Double_t nEvents, Int_t nWorkers, Bool_t verbose, 
+			       Bool_t autoBinned, const char* binnedTag, Bool_t extended) const ;
 
   // Implementation version
   virtual RooPlot* paramOn(RooPlot* frame, const RooArgSet& params, Bool_t showConstants=kFALSE,
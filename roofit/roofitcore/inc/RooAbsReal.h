@@ -113,6 +113,12 @@ public:
   }
   Bool_t getForceNumInt() const { return _forceNumInt ; }
 
+  // Analytical derivative support
+  virtual Bool_t hasAnalyticalDerivative(const RooAbsArg& param, const RooArgSet* normSet=0) const ;
+  virtual Double_t analyticalDerivative(const RooAbsArg& param, const RooArgSet* normSet=0) const ;
+  virtual Bool_t hasAnalyticalGradient(const RooArgList& params) const ;
+  virtual Bool_t analyticalGradient(const RooArgList& params, Double_t* grad) const ;
+
   // Chi^2 fits to histograms
   virtual RooFitResult* chi2FitTo(RooDataHist& data, const RooCmdArg& arg1=RooCmdArg::none(),  const RooCmdArg& arg2=RooCmdArg::none(),  
                               const RooCmdArg& arg3=RooCmdArg::none(),  const RooCmdArg& arg4=RooCmdArg::none(), const RooCmdArg& arg5=RooCmdArg::none(),  
@@ -469,6 +475,7 @@ protected:
 
   friend class RooRealSumPdf ;
   friend class RooRealSumFunc;
+  friend class RooNLLVar ;
   friend class RooAddPdf ;
   friend class RooAddModel ;
   void selectComp(Bool_t flag) { 
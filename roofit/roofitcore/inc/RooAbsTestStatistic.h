@@ -21,6 +21,7 @@
 #include "RooRealProxy.h"
 #include "TStopwatch.h"
 #include <string>
+#include <vector>
 
 class RooArgSet ;
 class RooAbsData ;
@@ -63,6 +64,11 @@ public:
   virtual Double_t offset() const { return _offset ; }
   virtual Double_t offsetCarry() const { return _offsetCarry; }
 
+  virtual Bool_t hasAnalyticalDerivative(const RooAbsArg& param, const RooArgSet* normSet=0) const ;
+  virtual Double_t analyticalDerivative(const RooAbsArg& param, const RooArgSet* normSet=0) const ;
+  virtual Bool_t hasAnalyticalGradient(const RooArgList& params) const ;
+  virtual Bool_t analyticalGradient(const RooArgList& params, Double_t* grad) const ;
+
 protected:
 
   virtual void printCompactTreeHook(std::ostream& os, const char* indent="") ;
@@ -72,6 +78,17 @@ protected:
 
   virtual Double_t evaluatePartition(Int_t firstEvent, Int_t lastEvent, Int_t stepSize) const = 0 ;
   virtual Double_t getCarry() const;
+  virtual Bool_t hasAnalyticalGradientPartition(const RooArgList& /*params*/) const { 
+    // Test statistics do not provide an analytical gradient by default
+    return kFALSE ; 
+  }
+  virtual void evaluateGradientPartition(const RooArgList& params, Double_t* grad, Int_t firstEvent, Int_t lastEvent, Int_t stepSize) const ;
+  Double_t sumSimComponents() const ;
+  Bool_t simComponentChanged(Int_t i) const ;
+  void clearSimComponentCache() const {
+    // Force recalculation of all component test statistics at the next evaluation in SimMaster mode
+    _gofCacheValid = kFALSE ;
+  }
 
   void setMPSet(Int_t setNum, Int_t numSets) ; 
   void setSimCount(Int_t simCount) { 
@@ -145,6 +162,12 @@ protected:
   mutable Double_t _offsetCarry; //! avoids loss of precision
   mutable Double_t _evalCarry; //! carry of Kahan sum in evaluatePartition
 
+  mutable std::vector<Double_t> _gofValue ; //! Value of each sub-context at its last calculation in SimMaster mode
+  mutable std::vector<Double_t> _gofCarry ; //! Kahan carry of each sub-context at its last calculation in SimMaster mode
+  mutable std::vector<std::vector<Double_t> > _gofParamValues ; //! Parameter values of each sub-context at its last calculation
+  mutable Bool_t _gofCacheValid ;           //! Are the cached sub-context values valid?
+  mutable Bool_t _gofCacheHideOffset ;      //! State of hideOffset() when the sub-context values were cached
+
   ClassDef(RooAbsTestStatistic,2) // Abstract base class for real-valued test statistics
 
 };
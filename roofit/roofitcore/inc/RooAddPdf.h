@@ -54,6 +54,9 @@ public:
     return kTRUE ; 
   }
 
+  virtual Bool_t hasAnalyticalDerivative(const RooAbsArg& param, const RooArgSet* normSet=0) const ;
+  virtual Double_t analyticalDerivative(const RooAbsArg& param, const RooArgSet* normSet=0) const ;
+
   virtual ExtendMode extendMode() const { 
     // Return extended mode capabilities
     return ((_haveLastCoef&&!_recursive) || _allExtendable) ? MustBeExtended : CanNotBeExtended; 
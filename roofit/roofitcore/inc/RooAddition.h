@@ -56,6 +56,11 @@ public:
 
   virtual void enableOffsetting(Bool_t) ;
 
+  virtual Bool_t hasAnalyticalDerivative(const RooAbsArg& param, const RooArgSet* normSet=0) const ;
+  virtual Double_t analyticalDerivative(const RooAbsArg& param, const RooArgSet* normSet=0) const ;
+  virtual Bool_t hasAnalyticalGradient(const RooArgList& params) const ;
+  virtual Bool_t analyticalGradient(const RooArgList& params, Double_t* grad) const ;
+
 protected:
 
   RooArgList   _ownedList ;      // List of owned components
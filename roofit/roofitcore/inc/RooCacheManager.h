@@ -26,6 +26,7 @@
 #include "RooAbsCache.h"
 #include "RooAbsCacheElement.h"
 #include "RooNameReg.h"
+#include "RooTrace.h"
 #include <vector>
 
 class RooNameSet ;
@@ -295,6 +296,7 @@ T* RooCacheManager<T>::getObj(const RooArgSet* nset, const RooArgSet* iset, Int_
   // Fast-track for wired mode
   if (_wired) {
     if(_object[0]==0 && sterileIdx) *sterileIdx=0 ;
+    if (RooTrace::profileEvalActive()) RooTrace::cacheAccess(_owner,_object[0]!=0) ;
     return _object[0] ;
   }
   
@@ -303,6 +305,7 @@ T* RooCacheManager<T>::getObj(const RooArgSet* nset, const RooArgSet* iset, Int_
     if (_nsetCache[i].contains(nset,iset,isetRangeName)==kTRUE) {      
       _lastIndex = i ;
       if(_object[i]==0 && sterileIdx) *sterileIdx=i ;
+      if (RooTrace::profileEvalActive()) RooTrace::cacheAccess(_owner,_object[i]!=0) ;
       return _object[i] ;
     }
   }
@@ -311,10 +314,12 @@ T* RooCacheManager<T>::getObj(const RooArgSet* nset, const RooArgSet* iset, Int_
     if (_nsetCache[i].autoCache(_owner,nset,iset,isetRangeName,kFALSE)==kFALSE) {
       _lastIndex = i ;
       if(_object[i]==0 && sterileIdx) *sterileIdx=i ;
+      if (RooTrace::profileEvalActive()) RooTrace::cacheAccess(_owner,_object[i]!=0) ;
       return _object[i] ;
     }
   }
 
+  if (RooTrace::profileEvalActive()) RooTrace::cacheAccess(_owner,kFALSE) ;
   return 0 ;
 }
 
@@ -36,6 +36,9 @@ public:
 
   const RooArgList& list() { return _set1 ; }
 
+  virtual Bool_t hasAnalyticalDerivative(const RooAbsArg& param, const RooArgSet* normSet=0) const ;
+  virtual Double_t analyticalDerivative(const RooAbsArg& param, const RooArgSet* normSet=0) const ;
+
 protected:
 
   RooListProxy _set1 ;    // Set of constraint terms
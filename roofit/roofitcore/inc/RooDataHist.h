@@ -99,6 +99,7 @@ public:
   }
   Double_t weightSquared() const ;
   Double_t weight(const RooArgSet& bin, Int_t intOrder=1, Bool_t correctForBinSize=kFALSE, Bool_t cdfBoundaries=kFALSE, Bool_t oneSafe=kFALSE) ;   
+  Bool_t weights(Double_t* output, Int_t n, const Double_t* const* coords, Bool_t correctForBinSize=kFALSE) const ;
   Double_t binVolume() const { return _curVolume ; }
   Double_t binVolume(const RooArgSet& bin) ; 
   virtual Bool_t valid() const ;
@@ -138,6 +139,7 @@ protected:
   friend class RooAbsOptTestStatistic ;
 
   Int_t calcTreeIndex() const ;
+  void initFastIndex() ;
   void cacheValidEntries() ;
 
   void setAllWeights(Double_t value) ;
@@ -194,6 +196,10 @@ protected:
   mutable RooCacheManager<std::vector<Double_t> > _pbinvCacheMgr ; //! Cache manager for arrays of partial bin volumes
   std::vector<RooAbsLValue*> _lvvars ; //! List of observables casted as RooAbsLValue
   std::vector<const RooAbsBinning*> _lvbins ; //! List of used binnings associated with lvalues
+  std::vector<const RooAbsReal*> _lvreals ; //! Observables of dimensions with uniform binning (null otherwise)
+  std::vector<Double_t> _lvxlo ; //! Lower bound of uniform binning per dimension
+  std::vector<Double_t> _lvbinw ; //! Bin width of uniform binning per dimension
+  std::vector<Int_t> _lvnbins ; //! Number of bins of uniform binning per dimension
   mutable std::vector<std::vector<Double_t> > _binbounds; //! list of bin bounds per dimension
 
   mutable Int_t _cache_sum_valid ; //! Is cache sum valid
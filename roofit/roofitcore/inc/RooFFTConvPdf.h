@@ -21,6 +21,7 @@
 class RooRealVar ;
 
 #include <map>
+#include <vector>
 
 ///PDF for the numerical (FFT) convolution of two PDFs.
 class RooFFTConvPdf : public RooAbsCachedPdf {
@@ -93,6 +94,21 @@ protected:
     RooAbsBinning* histBinning ;
     RooAbsBinning* scanBinning ;
 
+    // Fourier transforms of the sampled input p.d.f.s, kept per cache slice
+    // so that an input whose parameters did not change is not transformed again
+    Bool_t inputChanged(Int_t i) ;
+
+    std::vector<Double_t> paramVals1 ; // Parameter values of pdf1Clone for which spectrum1 was calculated
+    std::vector<Double_t> paramVals2 ; // Parameter values of pdf2Clone for which spectrum2 was calculated
+    std::vector<Double_t> spectrum1 ; // FFT of pdf1Clone samplings, (re,im) pairs for all slices
+    std::vector<Double_t> spectrum2 ; // FFT of pdf2Clone samplings, (re,im) pairs for all slices
+    Bool_t rescan1 ; // Sample and transform pdf1Clone in current fill
+    Bool_t rescan2 ; // Sample and transform pdf2Clone in current fill
+    Int_t nSlices ; // Number of slices stored in spectrum1/2
+    Int_t N ;  // Number of bins of the convolution observable
+    Int_t N2 ; // Number of bins including buffer zones
+    Int_t binShift1 ; // Position of zero bin in samplings of pdf1Clone
+
   };
 
   friend class FFTCacheElem ;  
@@ -103,7 +119,7 @@ protected:
   virtual RooArgSet* actualParameters(const RooArgSet& nset) const ;
   virtual RooAbsArg& pdfObservable(RooAbsArg& histObservable) const ;
   virtual void fillCacheObject(PdfCacheElem& cache) const ;
-  void fillCacheSlice(FFTCacheElem& cache, const RooArgSet& slicePosition) const ;
+  void fillCacheSlice(FFTCacheElem& cache, const RooArgSet& slicePosition, Int_t sliceIdx=0) const ;
 
   virtual PdfCacheElem* createCache(const RooArgSet* nset) const ;
   virtual TString histNameSuffix() const ;
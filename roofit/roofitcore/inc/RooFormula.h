@@ -17,14 +17,17 @@
 #define ROO_FORMULA
 
 #include "Rtypes.h"
-#include "v5/TFormula.h"
+#include "TNamed.h"
+#include "TFormula.h"
 #include "RooAbsReal.h"
 #include "RooArgSet.h"
 #include "RooPrintable.h"
 #include "RooLinkedList.h"
+#include <memory>
+#include <string>
 #include <vector>
 
-class RooFormula : public ROOT::v5::TFormula, public RooPrintable {
+class RooFormula : public TNamed, public RooPrintable {
 public:
   // Constructors etc.
   RooFormula() ;
@@ -72,10 +75,10 @@ protected:
   RooFormula& operator=(const RooFormula& other) ;
   void initCopy(const RooFormula& other) ;
 
-  // Interface to ROOT::v5::TFormula engine
-  Int_t DefinedVariable(TString &name, int& action) ; // ROOT 4
-  Int_t DefinedVariable(TString &name) ; // ROOT 3
-  Double_t DefinedValue(Int_t code) ;
+  // Interface to TFormula engine
+  Bool_t Compile(const char* expression=0) ;
+  std::string processFormula(const char* expression, Bool_t& ok) ;
+  Int_t DefinedVariable(TString &name) ;
 
   RooArgSet* _nset ;
   mutable Bool_t    _isOK ;     // Is internal state OK?
@@ -83,10 +86,12 @@ protected:
   std::vector<Bool_t> _useIsCat;//! Is given slot in _useList a category?
   RooLinkedList _useList ;      //! List of actual dependents 
   mutable RooArgSet _actual;    //! Set of actual dependents
-  RooLinkedList _labelList ;    //  List of label names for category objects  
+  std::vector<std::string> _labelList ; //! Label names for category objects in _useList
   mutable Bool_t    _compiled ; //  Flag set if formula is compiled
+  std::vector<Double_t> _argValues ;   //! Argument buffer passed to compiled formula
+  std::unique_ptr<TFormula> _tFormula ; //! JIT-compiled formula with @N/name references replaced by x[N]
 
-  ClassDef(RooFormula,1)     // ROOT::v5::TFormula derived class interfacing with RooAbsArg objects
+  ClassDef(RooFormula,2)     // TFormula based class interfacing with RooAbsArg objects
 };
 
 #endif
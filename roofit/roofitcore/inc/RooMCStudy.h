@@ -54,6 +54,10 @@ public:
   Bool_t fit(Int_t nSamples, TList& dataSetList) ;
   Bool_t addFitResult(const RooFitResult& fr) ;
 
+  // Parallel and reproducible running
+  void setParallel(Int_t nWorkers) ;
+  void setToySeed(UInt_t seed) ;
+
   // Result accessors
   const RooArgSet* fitParams(Int_t sampleNum) const ;
   const RooFitResult* fitResult(Int_t sampleNum) const ;
@@ -103,6 +107,9 @@ protected:
   RooPlot* makeFrameAndPlotCmd(const RooRealVar& param, RooLinkedList& cmdList, Bool_t symRange=kFALSE) const ;
 
   Bool_t run(Bool_t generate, Bool_t fit, Int_t nSamples, Int_t nEvtPerSample, Bool_t keepGenData, const char* asciiFilePat) ;
+  void runSamples(Bool_t generate, Bool_t fit, Int_t firstSample, Int_t nSamples, Int_t nEvtPerSample, Bool_t keepGenData, const char* asciiFilePat) ;
+  Bool_t runParallel(Bool_t generate, Bool_t fit, Int_t nSamples, Int_t nEvtPerSample, Bool_t keepGenData, const char* asciiFilePat,
+		     std::list<RooDataSet*>& auxDataList) ;
   Bool_t fitSample(RooAbsData* genSample) ;
   RooFitResult* doFit(RooAbsData* genSample) ;	
 
@@ -142,6 +149,8 @@ protected:
   Bool_t      _verboseGen       ; // Verbose generation?
   Bool_t      _perExptGenParams ; // Do generation parameter change per event?
   Bool_t      _silence          ; // Silent running mode?
+  Int_t       _nWorkers         ; // Number of parallel worker processes
+  UInt_t      _toySeed          ; // Base seed for per-sample reseeding (0 = no reseeding)
 
   std::list<RooAbsMCStudyModule*> _modList ; // List of additional study modules ;
 
@@ -51,6 +51,7 @@ public:
   void setOffsetting(Bool_t flag) ;
   void setMaxIterations(Int_t n) ;
   void setMaxFunctionCalls(Int_t n) ; 
+  void setUseGradient(Bool_t flag=kTRUE) ;
 
   RooFitResult* fit(const char* options) ;
 
@@ -73,6 +74,8 @@ public:
   void setPrintEvalErrors(Int_t numEvalErrors) { fitterFcn()->SetPrintEvalErrors(numEvalErrors); }
   void setVerbose(Bool_t flag=kTRUE) { _verbose = flag ; fitterFcn()->SetVerbose(flag); }
   void setProfile(Bool_t flag=kTRUE) { _profile = flag ; }
+  void setEvalProfile(Bool_t flag=kTRUE) ;
+  void printEvalProfile(std::ostream& os, Int_t maxNodes=20) const ;
   Bool_t setLogFile(const char* logf=0) { return fitterFcn()->SetLogFile(logf); }
 
   void setMinimizerType(const char* type) ;
@@ -100,8 +103,10 @@ protected:
   inline std::ofstream* logfile() { return fitterFcn()->GetLogFile(); }
   inline Double_t& maxFCN() { return fitterFcn()->GetMaxFCN() ; }
   
-  const RooMinimizerFcn* fitterFcn() const {  return ( fitter()->GetFCN() ? ((RooMinimizerFcn*) fitter()->GetFCN()) : _fcn ) ; }
-  RooMinimizerFcn* fitterFcn() { return ( fitter()->GetFCN() ? ((RooMinimizerFcn*) fitter()->GetFCN()) : _fcn ) ; }
+  const RooMinimizerFcn* fitterFcn() const {  return ( fitter()->GetFCN() ? dynamic_cast<RooMinimizerFcn*>(fitter()->GetFCN()) : _fcn ) ; }
+  RooMinimizerFcn* fitterFcn() { return ( fitter()->GetFCN() ? dynamic_cast<RooMinimizerFcn*>(fitter()->GetFCN()) : _fcn ) ; }
+
+  bool fitFcn() const ;
 
 private:
 
@@ -112,9 +117,11 @@ private:
   RooAbsReal* _func ;
 
   Bool_t      _verbose ;
+  Bool_t      _useGradient ;
   TStopwatch  _timer ;
   TStopwatch  _cumulTimer ;
   Bool_t      _profileStart ;
+  Bool_t      _evalProfile ;
 
   TMatrixDSym* _extV ;
 
@@ -30,7 +30,7 @@
 
 class RooMinimizer;
 
-class RooMinimizerFcn : public ROOT::Math::IBaseFunctionMultiDim {
+class RooMinimizerFcn : public ROOT::Math::IMultiGradFunction {
 
  public:
 
@@ -64,6 +64,11 @@ class RooMinimizerFcn : public ROOT::Math::IBaseFunctionMultiDim {
   Int_t evalCounter() const { return _evalCounter ; }
   void zeroEvalCount() { _evalCounter = 0 ; }
 
+  void SetUseGradient(Bool_t flag=kTRUE) { _useGradient = flag ; }
+  Bool_t UseGradient() const ;
+  virtual void Gradient(const double* x, double* grad) const ;
+  virtual void FdF(const double* x, double& f, double* df) const ;
+
 
  private:
   
@@ -77,6 +82,7 @@ class RooMinimizerFcn : public ROOT::Math::IBaseFunctionMultiDim {
 
 
   virtual double DoEval(const double * x) const;  
+  virtual double DoDerivative(const double * x, unsigned int icoord) const;
   void updateFloatVec() ;
 
 private:
@@ -94,6 +100,7 @@ private:
   int _nDim;
   std::ofstream *_logfile;
   bool _verbose;
+  Bool_t _useGradient;
 
   RooArgList* _floatParamList;
   std::vector<RooAbsArg*> _floatParamVec ;
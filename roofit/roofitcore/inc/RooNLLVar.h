@@ -27,7 +27,7 @@ class RooNLLVar : public RooAbsOptTestStatistic {
 public:
 
   // Constructors, assignment etc
-  RooNLLVar() { _first = kTRUE ; }
+  RooNLLVar() { _first = kTRUE ; _binnedCacheOK = kFALSE ; }
   RooNLLVar(const char *name, const char* title, RooAbsPdf& pdf, RooAbsData& data,
 	    const RooCmdArg& arg1=RooCmdArg::none(), const RooCmdArg& arg2=RooCmdArg::none(),const RooCmdArg& arg3=RooCmdArg::none(),
 	    const RooCmdArg& arg4=RooCmdArg::none(), const RooCmdArg& arg5=RooCmdArg::none(),const RooCmdArg& arg6=RooCmdArg::none(),
@@ -56,6 +56,9 @@ public:
 
   void applyWeightSquared(Bool_t flag) ; 
 
+  Bool_t setDataSlave(RooAbsData& data, Bool_t cloneData=kTRUE, Bool_t ownNewDataAnyway=kFALSE) ;
+  void constOptimizeTestStatistic(ConstOpCode opcode, Bool_t doAlsoTrackingOpt=kTRUE) ;
+
   virtual Double_t defaultErrorLevel() const { return 0.5 ; }
 
 protected:
@@ -66,6 +69,8 @@ protected:
 
   Bool_t _extended ;
   virtual Double_t evaluatePartition(Int_t firstEvent, Int_t lastEvent, Int_t stepSize) const ;
+  virtual Bool_t hasAnalyticalGradientPartition(const RooArgList& params) const ;
+  virtual void evaluateGradientPartition(const RooArgList& params, Double_t* grad, Int_t firstEvent, Int_t lastEvent, Int_t stepSize) const ;
   Bool_t _weightSq ; // Apply weights squared?
   mutable Bool_t _first ; //!
   Double_t _offsetSaveW2; //!
@@ -73,6 +78,18 @@ protected:
 
   mutable std::vector<Double_t> _binw ; //!
   mutable RooRealSumPdf* _binnedPdf ; //!
+
+  // Binned likelihood: values of the component FUNCs of _binnedPdf in each bin,
+  // recalculated only for components whose parameters or shape changed
+  virtual Bool_t redirectServersHook(const RooAbsCollection& newServerList, Bool_t mustReplaceAll, Bool_t nameChange, Bool_t isRecursive) ;
+  void updateBinnedCache(Int_t firstEvent, Int_t lastEvent, Int_t stepSize) const ;
+  mutable Bool_t _binnedCacheOK ; //! Are the component node lists filled?
+  mutable Int_t _binnedCachePart[3] ; //! Partition (first,last,step) for which the cache was filled
+  mutable std::vector<RooArgList> _binnedFuncPars ; //! Observable-independent nodes of each component FUNC
+  mutable std::vector<RooArgList> _binnedFuncObsNodes ; //! Observable-dependent function nodes of each component FUNC
+  mutable std::vector<std::vector<Double_t> > _binnedFuncParVals ; //! Node values for which component values were filled
+  mutable std::vector<std::vector<Double_t> > _binnedFuncVals ; //! Value of each component FUNC in each bin
+  mutable std::vector<Bool_t> _binnedFuncFilled ; //! Are the bin values of each component FUNC filled?
    
   ClassDef(RooNLLVar,2) // Function representing (extended) -log(L) of p.d.f and dataset
 };
@@ -59,6 +59,9 @@ public:
   virtual CacheMode canNodeBeCached() const { return RooAbsArg::NotAdvised ; } ;
   virtual void setCacheAndTrackHints(RooArgSet&) ;
 
+  virtual Bool_t hasAnalyticalDerivative(const RooAbsArg& param, const RooArgSet* normSet=0) const ;
+  virtual Double_t analyticalDerivative(const RooAbsArg& param, const RooArgSet* normSet=0) const ;
+
 protected:
 
   RooListProxy _compRSet ;
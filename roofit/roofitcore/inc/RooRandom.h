@@ -32,6 +32,7 @@ public:
   static void uniform(UInt_t dimension, Double_t vector[], TRandom *generator= randomGenerator());
   static UInt_t integer(UInt_t max, TRandom *generator= randomGenerator());
   static Double_t gaussian(TRandom *generator= randomGenerator());
+  static UInt_t derivedSeed(UInt_t baseSeed, ULong64_t index);
 
   static RooQuasiRandomGenerator *quasiGenerator();
   static Bool_t quasi(UInt_t dimension, Double_t vector[],
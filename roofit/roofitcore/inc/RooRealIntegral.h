@@ -22,6 +22,7 @@
 #include "RooRealProxy.h"
 #include "RooSetProxy.h"
 #include "RooListProxy.h"
+#include <vector>
 
 class RooArgSet ;
 class TH1F ;
@@ -70,6 +71,11 @@ public:
 
   static Int_t getCacheAllNumeric() ;
 
+  static void setNumIntCacheSize(Int_t nEntries) ;
+  static Int_t getNumIntCacheSize() ;
+  static void setNumIntCacheTolerance(Double_t relTol) ;
+  static Double_t getNumIntCacheTolerance() ;
+
   virtual std::list<Double_t>* plotSamplingHint(RooAbsRealLValue& obs, Double_t xlo, Double_t xhi) const {
     // Forward plot sampling hint of integrand
     return _function.arg().plotSamplingHint(obs,xlo,xhi) ;
@@ -141,6 +147,19 @@ protected:
   Bool_t _cacheNum ;           // Cache integral if numeric
   static Int_t _cacheAllNDim ; //! Cache all integrals with given numeric dimension
 
+  // Values of numeric integrals for recently used parameter points
+  Bool_t numIntCacheActive() const ;
+  void numIntCacheKey(std::vector<Double_t>& key) const ;
+  Bool_t numIntCacheLookup(Double_t& value) const ;
+  void numIntCacheStore(Double_t value) const ;
+
+  mutable std::vector<std::vector<Double_t> > _numIntCacheKeys ; //! Parameter values and limits of cached integrals
+  mutable std::vector<Double_t> _numIntCacheVals ;   //! Cached integral values
+  mutable std::vector<Double_t> _numIntCacheCurKey ; //! Key for current parameter values
+  mutable Int_t _numIntCacheNext ;                   //! Slot for next cached value
+  static Int_t _numIntCacheSize ;                    //! Number of cached parameter points per integral
+  static Double_t _numIntCacheTol ;                  //! Relative tolerance for reuse of cached values
+
 
   virtual void operModeHook() ; // cache operation mode
 
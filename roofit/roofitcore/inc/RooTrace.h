@@ -18,6 +18,13 @@
 
 #include <assert.h>
 #include "RooLinkedList.h"
+#include <chrono>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class RooAbsArg ;
 
 #define TRACE_CREATE
 #define TRACE_DESTROY 
@@ -50,10 +57,44 @@ public:
 
   static void printObjectCounts() ;
 
+  // Per-node evaluation profiling
+  static void profileEval(Bool_t flag) ;
+  static Bool_t profileEvalActive() { return _profileEval ; }
+  static void resetEvalProfile() ;
+  static void printEvalProfile(std::ostream& os, Int_t maxNodes=20) ;
+
+  static void evalStart(const RooAbsArg* arg) ;
+  static void evalStop() ;
+  static void valueCacheHit(const RooAbsArg* arg) ;
+  static void cacheAccess(const RooAbsArg* owner, Bool_t hit) ;
+  static Bool_t evalProfileFilled() { return _profileEvalFilled ; }
+  static void evalProfileRemove(const RooAbsArg* arg) ;
+
 
 protected:
 
   static RooTrace* _instance ;
+  static Bool_t _profileEval ;
+  static Bool_t _profileEvalFilled ;
+
+  struct EvalProfileEntry {
+    std::string _name ;
+    std::string _className ;
+    Long64_t _nCalls = 0 ;      // Number of getVal() calls
+    Long64_t _nEvals = 0 ;      // Number of calls that required evaluation
+    Long64_t _nCacheHits = 0 ;  // Hits in normalization/object caches owned by the node
+    Long64_t _nCacheMiss = 0 ;  // Misses in normalization/object caches owned by the node
+    Double_t _inclTime = 0 ;    // Time spent in evaluation, including servers [s]
+    Double_t _exclTime = 0 ;    // Time spent in evaluation, excluding servers [s]
+  } ;
+
+  struct EvalFrame {
+    EvalProfileEntry* _entry ;
+    std::chrono::steady_clock::time_point _start ;
+    Double_t _childTime ;
+  } ;
+
+  EvalProfileEntry& profileEntry(const RooAbsArg* arg) ;
 
   void dump3(std::ostream&, Bool_t sinceMarked) ;
 
@@ -80,6 +121,10 @@ protected:
   std::map<std::string,int> _specialCount ;
   std::map<std::string,int> _specialSize ;
 
+  std::unordered_map<const RooAbsArg*,EvalProfileEntry> _evalProfile ; //! Per-node evaluation profile of live nodes
+  std::vector<EvalProfileEntry> _evalProfileDeleted ; //! Evaluation profile of nodes deleted since
+  std::vector<EvalFrame> _evalStack ; //! Stack of nodes being evaluated
+
   ClassDef(RooTrace,0) // Memory tracer utility for RooFit objects
 };
 
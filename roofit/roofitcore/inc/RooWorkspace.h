@@ -25,6 +25,7 @@
 #include <map>
 #include <list>
 #include <string>
+#include <vector>
 #include "ROOT/RMakeUnique.hxx"
 
 class TClass ;
@@ -146,6 +147,12 @@ public:
   void Print(Option_t* opts=0) const ;
 
   static void autoImportClassCode(Bool_t flag) ;
+
+  void setLazyDataIO(Bool_t flag=kTRUE) { _lazyDataIO = flag ; }
+  Bool_t isDataLoaded(const char* name) const { 
+    // Is the dataset with given name deserialized? Datasets written with setLazyDataIO() are loaded on first access
+    return _dataList.FindObject(name)!=0 ; 
+  }
  
   static void addClassDeclImportDir(const char* dir) ;
   static void addClassImplImportDir(const char* dir) ;
@@ -238,6 +245,19 @@ public:
   } ;
 
 
+  class DataBuffer : public TNamed {
+  public:
+    DataBuffer() {} ;
+    DataBuffer(const char* name, const char* buf, Int_t len) : TNamed(name,name), _buf(buf,buf+len) {} ;
+    const std::vector<char>& buffer() const { return _buf ; }
+
+  protected:
+    std::vector<char> _buf ; // Serialized dataset
+
+    ClassDef(DataBuffer,1) ; // Serialized dataset stored in a RooWorkspace for loading on first access
+  } ;
+
+
  private:
     friend class RooAbsArg;
     friend class RooAbsPdf;
@@ -247,6 +267,9 @@ public:
     void exportObj(TObject *obj);
     void unExport();
 
+    RooAbsData* loadData(const char* name) const;
+    void loadAllData() const;
+
     friend class CodeRepo;
     static std::list<std::string> _classDeclDirList;
     static std::list<std::string> _classImplDirList;
@@ -260,6 +283,7 @@ public:
 
     RooArgSet _allOwnedNodes;                    // List of owned pdfs and components
     RooLinkedList _dataList;                     // List of owned datasets
+    mutable RooLinkedList _dataBuffers;          // List of owned datasets that are not yet deserialized
     RooLinkedList _embeddedDataList;             // List of owned datasets that are embedded in pdfs
     RooLinkedList _views;                        // List of model views
     RooLinkedList _snapshots;                    // List of parameter snapshots
@@ -279,7 +303,9 @@ public:
     Bool_t _openTrans;       //! Is there a transaction open?
     RooArgSet _sandboxNodes; //! Sandbox for incoming objects in a transaction
 
-    ClassDef(RooWorkspace, 8) // Persistable project container for (composite) pdfs, functions, variables and datasets
+    Bool_t _lazyDataIO; //! Write datasets as separate buffers that are only deserialized when accessed
+
+    ClassDef(RooWorkspace, 9) // Persistable project container for (composite) pdfs, functions, variables and datasets
 } ;
 
 #endif
@@ -204,6 +204,11 @@ RooAbsArg::~RooAbsArg()
     _ownedComponents = 0 ;
   }
 
+  // Detach evaluation profile data from this address
+  if (RooTrace::evalProfileFilled()) {
+    RooTrace::evalProfileRemove(this) ;
+  }
+
 }
 
 
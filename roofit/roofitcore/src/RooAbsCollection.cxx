@@ -58,11 +58,13 @@ char* operator+( streampos&, char* );
 ClassImp(RooAbsCollection);
   ;
 
+Int_t RooAbsCollection::_defaultHashThresh = 32 ;
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Default constructor
 
 RooAbsCollection::RooAbsCollection() :
-  _list(0),
+  _list(_defaultHashThresh),
   _ownCont(kFALSE),
   _name(),
   _allRRV(kTRUE)
@@ -75,7 +77,7 @@ RooAbsCollection::RooAbsCollection() :
 /// Empty collection constructor
 
 RooAbsCollection::RooAbsCollection(const char *name) :
-  _list(0),
+  _list(_defaultHashThresh),
   _ownCont(kFALSE),
   _name(name),
   _allRRV(kTRUE)
@@ -92,7 +94,7 @@ RooAbsCollection::RooAbsCollection(const char *name) :
 RooAbsCollection::RooAbsCollection(const RooAbsCollection& other, const char *name) :
   TObject(other),
   RooPrintable(other),
-  _list(other._list.getHashTableSize()) ,
+  _list(other._list.getHashTableSize()>0 ? other._list.getHashTableSize() : _defaultHashThresh) ,
   _ownCont(kFALSE),
   _name(name),
   _allRRV(other._allRRV)
@@ -110,6 +112,24 @@ RooAbsCollection::RooAbsCollection(const RooAbsCollection& other, const char *na
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Set the collection size above which newly created collections automatically
+/// build a hash table for lookups by name and by argument. Below this size
+/// find() scans the list linearly, which is faster for the small sets that
+/// dominate normalization-set handling. A value of zero disables automatic
+/// hashing; setHashTableSize() can still be used on individual collections.
+
+void RooAbsCollection::setDefaultHashThreshold(Int_t thresh)
+{
+  if (thresh<0) {
+    oocoutE((TObject*)0,InputArguments) << "RooAbsCollection::setDefaultHashThreshold() ERROR threshold must not be negative" << endl ;
+    return ;
+  }
+  _defaultHashThresh = thresh ;
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Destructor
 
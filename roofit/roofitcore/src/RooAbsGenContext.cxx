@@ -276,6 +276,18 @@ void RooAbsGenContext::initGenerator(const RooArgSet&)
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Perform the initialization that generate() does before the first event
+/// without generating any events. Subsequent calls to generate() can then
+/// skip the initialization.
+
+void RooAbsGenContext::initialize() 
+{
+  initGenerator(*_theEvent) ;
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Print name of context
 
@@ -527,7 +527,8 @@ void RooAbsOptTestStatistic::constOptimizeTestStatistic(ConstOpCode opcode, Bool
     return ;
   }
 
-  if (_dataClone->hasFilledCache() && opcode==Activate) {
+  // Repeated activation updates the existing optimization for the current parameter values
+  if ((_dataClone->hasFilledCache() || _optimized) && opcode==Activate) {
     opcode=ValueChange ;
   }
 
@@ -559,6 +560,14 @@ void RooAbsOptTestStatistic::constOptimizeTestStatistic(ConstOpCode opcode, Bool
     // Request a forcible cache update of all cached nodes
     _dataClone->store()->forceCacheUpdate() ;
 
+    // Refold constant expressions that do not depend on the observables with
+    // the new parameter values, as folded nodes do not track value changes
+    if (_optimized) {
+      foldConstantNodes(kFALSE) ;
+      _funcClone->getVal(_normSet) ;
+      foldConstantNodes(kTRUE) ;
+    }
+
     break ;
   }
 
@@ -717,10 +726,16 @@ void RooAbsOptTestStatistic::optimizeConstantTerms(Bool_t activate, Bool_t apply
     // Disable reading of observables that are no longer used
     _dataClone->optimizeReadingWithCaching(*_funcClone, _cachedNodes,requiredExtraObservables()) ;
 
+    // Freeze constant expressions that do not depend on the observables
+    foldConstantNodes(kTRUE) ;
+
     _optimized = kTRUE ;
 
   } else {
     
+    // Return frozen constant expressions to regular change tracking
+    foldConstantNodes(kFALSE) ;
+
     // Delete the cache
     _dataClone->resetCache() ;
     
@@ -742,6 +757,66 @@ void RooAbsOptTestStatistic::optimizeConstantTerms(Bool_t activate, Bool_t apply
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Fold constant terms that do not depend on the observables. Functions
+/// (not p.d.f.s) in the expression tree that depend exclusively on constant
+/// parameters, and that hold a valid value from the evaluation of the
+/// expression tree in optimizeConstantTerms(), are put in AClean mode, so that
+/// they no longer take part in the change tracking of the tree and are never
+/// evaluated again during the minimization. Constant terms that depend on the
+/// observables are cached with the dataset by optimizeConstantTerms().
+/// If activate is false, the folded nodes are returned to the regular
+/// change tracking mode. Folded nodes must be refolded when the value of
+/// a constant parameter changes, which is done on ValueChange in
+/// constOptimizeTestStatistic().
+
+void RooAbsOptTestStatistic::foldConstantNodes(Bool_t activate)
+{
+  if (!activate) {
+    RooFIter iter = _foldedNodes.fwdIterator() ;
+    RooAbsArg* node ;
+    while((node=iter.next())) {
+      node->setOperMode(RooAbsArg::Auto) ;
+      node->setValueDirty() ;
+    }
+    _foldedNodes.removeAll() ;
+    return ;
+  }
+
+  RooArgSet branches ;
+  _funcClone->branchNodeServerList(&branches) ;
+  RooFIter iter = branches.fwdIterator() ;
+  RooAbsArg* node ;
+  while((node=iter.next())) {
+    if (!dynamic_cast<RooAbsReal*>(node) || dynamic_cast<RooAbsPdf*>(node) || node==_funcClone) continue ;
+    if (node->operMode()!=RooAbsArg::Auto || node->isValueDirty() || _cachedNodes.find(*node)) continue ;
+    if (node->getAttribute("NeverConstant") || node->getAttribute("CacheAndTrack")) continue ;
+    if (node->dependsOnValue(*_funcObsSet)) continue ;
+
+    Bool_t canFold(kTRUE) ;
+    RooArgSet* paramSet = node->getParameters(*_funcObsSet) ;
+    RooFIter piter = paramSet->fwdIterator() ;
+    RooAbsArg* param ;
+    while((param = piter.next())) {
+      if (!param->isConstant()) {
+        canFold=kFALSE ;
+        break ;
+      }
+    }
+    delete paramSet ;
+    if (!canFold) continue ;
+
+    node->setOperMode(RooAbsArg::AClean) ;
+    _foldedNodes.add(*node) ;
+  }
+
+  if (_foldedNodes.getSize()>0) {
+    coutI(Minimization) << " A total of " << _foldedNodes.getSize() << " constant expressions that do not depend on observables have been folded." << endl ;
+  }
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 ///   cout << "RAOTS::setDataSlave(" << this << ") START" << endl ;
 /// Change dataset that is used to given one. If cloneData is kTRUE, a clone of
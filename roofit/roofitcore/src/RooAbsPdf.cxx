@@ -113,6 +113,7 @@ the proxy holds a function, and will trigger an assert
 
 #include "RooFit.h"
 #include "RooMsgService.h" 
+#include "RooTrace.h"
 
 #include "TClass.h"
 #include "Riostream.h"
@@ -160,6 +161,11 @@ the proxy holds a function, and will trigger an assert
 #include "Math/CholeskyDecomp.h"
 #include <string>
 
+#ifndef _WIN32
+#include "ROOT/TProcessExecutor.hxx"
+#include "ROOT/TSeq.hxx"
+#endif
+
 using namespace std;
 
 ClassImp(RooAbsPdf); 
@@ -262,7 +268,9 @@ Double_t RooAbsPdf::getValV(const RooArgSet* nset) const
   if (!nset) {
     RooArgSet* tmp = _normSet ;
     _normSet = 0 ;
+    if (RooTrace::profileEvalActive()) RooTrace::evalStart(this) ;
     Double_t val = evaluate() ;
+    if (RooTrace::profileEvalActive()) RooTrace::evalStop() ;
     _normSet = tmp ;
     Bool_t error = traceEvalPdf(val) ;
 
@@ -283,6 +291,9 @@ Double_t RooAbsPdf::getValV(const RooArgSet* nset) const
   // Return value of object. Calculated if dirty, otherwise cached value is returned.
   if (isValueDirty() || nsetChanged || _norm->isValueDirty()) {
 
+    const Bool_t profile = RooTrace::profileEvalActive() ;
+    if (profile) RooTrace::evalStart(this) ;
+
     // Evaluate numerator
     Double_t rawVal = evaluate() ;
     Bool_t error = traceEvalPdf(rawVal) ; // Error checking and printing
@@ -305,7 +316,11 @@ Double_t RooAbsPdf::getValV(const RooArgSet* nset) const
     }
 
     clearValueAndShapeDirty() ; //setValueDirty(kFALSE) ;
-  } 
+
+    if (profile) RooTrace::evalStop() ;
+  } else if (RooTrace::profileEvalActive()) {
+    RooTrace::valueCacheHit(this) ;
+  }
 
   return _value ;
 }
@@ -1730,6 +1745,11 @@ RooAbsGenContext* RooAbsPdf::autoGenContext(const RooArgSet &vars, const RooData
 ///               copy of the prototype dataset with only variables in whatVars randomized. Variables in whatVars that 
 ///               are not in the prototype will be added as new columns to the generated dataset. 
 ///
+/// <tr><td> `NumCPU(int nCPU)`                  <td> Distribute the generation of events without prototype data over nCPU forked
+///                                                 worker processes, each seeded from a base seed drawn from the current generator.
+///                                                 The result is reproducible for a given seed and number of workers.
+///                                                 Binned and expected-data generation always run in a single process.
+///
 /// </table>
 ///
 
@@ -1749,6 +1769,7 @@ RooDataSet *RooAbsPdf::generate(const RooArgSet& whatVars, const RooCmdArg& arg1
   pc.defineInt("expectedData","ExpectedData",0,0) ;
   pc.defineDouble("nEventsD","NumEventsD",0,-1.) ;
   pc.defineString("binnedTag","GenBinned",0,"") ;
+  pc.defineInt("nCPU","NumCPU",0,1) ;
   pc.defineMutex("GenBinned","ProtoData") ;
     
   // Process and check varargs 
@@ -1770,6 +1791,7 @@ RooDataSet *RooAbsPdf::generate(const RooArgSet& whatVars, const RooCmdArg& arg1
   Double_t nEventsD = pc.getInt("nEventsD") ;
   //Bool_t verbose = pc.getInt("verbose") ;
   Bool_t expectedData = pc.getInt("expectedData") ;
+  Int_t nCPU = pc.getInt("nCPU") ;
 
   Double_t nEvents = (nEventsD>0) ? nEventsD : Double_t(nEventsI); 
 
@@ -1802,12 +1824,14 @@ RooDataSet *RooAbsPdf::generate(const RooArgSet& whatVars, const RooCmdArg& arg1
   RooDataSet* data ;
   if (protoData) {
     data = generate(whatVars,*protoData,Int_t(nEvents),verbose,randProto,resampleProto) ;
+  } else if (nCPU>1 && !expectedData) {
+    data = generateParallel(whatVars,nEvents,nCPU,verbose,autoBinned,binnedTag,extended) ;
   } else {
      data = generate(whatVars,nEvents,verbose,autoBinned,binnedTag,expectedData, extended) ;
   }
 
   // Rename dataset to given name if supplied
-  if (dsetName && strlen(dsetName)>0) {
+  if (data && dsetName && strlen(dsetName)>0) {
     data->SetName(dsetName) ;
   }
 
@@ -1928,6 +1952,92 @@ RooDataSet *RooAbsPdf::generate(const RooArgSet &whatVars, Double_t nEvents, Boo
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Generate nEvents events, or expectedEvents() if nEvents is not positive,
+/// in nWorkers forked worker processes. A p.d.f. that cannot be extended is
+/// handled as in generate() if nEvents is not positive. The generator context is created and
+/// initialized once in this process, after which each worker generates a
+/// contiguous share of the events with the random generator seeded by
+/// RooRandom::derivedSeed() from a common base seed and the worker number.
+/// For an extended generation the total number of events is drawn from a
+/// Poisson distribution before the events are distributed. The datasets of
+/// the workers are appended in worker order; if any worker fails, zero is
+/// returned. Binned generation, where events
+/// are bins with weights, falls back to generation in this process, as
+/// does running on platforms that do not support forking.
+
+RooDataSet *RooAbsPdf::generateParallel(const RooArgSet &whatVars, Double_t nEvents, Int_t nWorkers, Bool_t verbose, 
+					Bool_t autoBinned, const char* binnedTag, Bool_t extended) const 
+{
+#ifndef _WIN32
+  if ((autoBinned && isBinnedDistribution(whatVars)) || (binnedTag && strlen(binnedTag)>0)) {
+    return generate(whatVars,nEvents,verbose,autoBinned,binnedTag,kFALSE,extended) ;
+  }
+
+  if (nEvents<=0) {
+    if (extendMode()==CanNotBeExtended) {
+      return generate(whatVars,nEvents,verbose,autoBinned,binnedTag,kFALSE,extended) ;
+    }
+    nEvents = expectedEvents(&whatVars) ;
+  }
+  const Int_t nTotal = extended ? RooRandom::randomGenerator()->Poisson(nEvents) : Int_t(ceil(nEvents)) ;
+  if (nTotal<=0) {
+    return new RooDataSet("emptyData","emptyData",whatVars) ;
+  }
+  if (nWorkers>nTotal) nWorkers = nTotal ;
+
+  RooAbsGenContext* context = autoGenContext(whatVars,0,0,verbose,autoBinned,binnedTag) ;
+  if (!context || !context->isValid()) {
+    coutE(Generation) << "RooAbsPdf::generate(" << GetName() << ") cannot create a valid context" << endl;
+    delete context ;
+    return 0 ;
+  }
+
+  // Initialize the generator here, such that all workers inherit the same
+  // setup (e.g. the function maximum of accept/reject sampling) and skip it
+  context->initialize() ;
+
+  const UInt_t baseSeed = RooRandom::randomGenerator()->Integer(TMath::Limits<UInt_t>::Max()) ;
+  coutI(Generation) << "RooAbsPdf::generate(" << GetName() << ") generating " << nTotal << " events in " 
+		    << nWorkers << " worker processes, base seed is " << baseSeed << endl ;
+
+  auto generateShare = [&](UInt_t iWorker) {
+    const Int_t nShare = Int_t(nTotal*Long64_t(iWorker+1)/nWorkers - nTotal*Long64_t(iWorker)/nWorkers) ;
+    RooRandom::randomGenerator()->SetSeed(RooRandom::derivedSeed(baseSeed,iWorker)) ;
+    return context->generate(nShare,kTRUE,kFALSE) ;
+  } ;
+
+  ROOT::TProcessExecutor workers(nWorkers) ;
+  std::vector<RooDataSet*> shares = workers.Map(generateShare, ROOT::TSeqU(nWorkers)) ;
+  delete context ;
+
+  // As in the serial generation, a failure gives no dataset at all
+  Bool_t ok(kTRUE) ;
+  for (Int_t iWorker=0 ; iWorker<nWorkers ; iWorker++) {
+    if (!shares[iWorker]) {
+      coutE(Generation) << "RooAbsPdf::generate(" << GetName() << ") ERROR no events received from worker " << iWorker << endl ;
+      ok = kFALSE ;
+    }
+  }
+  if (!ok) {
+    for (RooDataSet* share : shares) delete share ;
+    return 0 ;
+  }
+
+  RooDataSet* generated = shares[0] ;
+  for (Int_t iWorker=1 ; iWorker<nWorkers ; iWorker++) {
+    generated->append(*shares[iWorker]) ;
+    delete shares[iWorker] ;
+  }
+  return generated ;
+#else
+  (void)nWorkers ;
+  return generate(whatVars,nEvents,verbose,autoBinned,binnedTag,kFALSE,extended) ;
+#endif
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Internal method  
 
@@ -47,6 +47,7 @@
 #include "RooCurve.h"
 #include "RooRealVar.h"
 #include "RooArgProxy.h"
+#include "RooTrace.h"
 #include "RooFormulaVar.h"
 #include "RooRealBinding.h"
 #include "RooRealIntegral.h"
@@ -253,8 +254,16 @@ Double_t RooAbsReal::getValV(const RooArgSet* nset) const
   }
 
   if (isValueDirtyAndClear()) {
-    _value = traceEval(nset) ;
+    if (RooTrace::profileEvalActive()) {
+      RooTrace::evalStart(this) ;
+      _value = traceEval(nset) ;
+      RooTrace::evalStop() ;
+    } else {
+      _value = traceEval(nset) ;
+    }
     //     clearValueDirty() ;
+  } else if (RooTrace::profileEvalActive()) {
+    RooTrace::valueCacheHit(this) ;
   }
   //   cout << "RooAbsReal::getValV(" << GetName() << ") writing _value = " << _value << endl ;
 
@@ -368,6 +377,73 @@ Double_t RooAbsReal::analyticalIntegral(Int_t code, const char* /*rangeName*/) c
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return true if analyticalDerivative() can calculate the derivative of
+/// getVal(normSet) with respect to 'param'. The default implementation
+/// only knows the trivial cases: the derivative of an object with respect
+/// to itself, and of an object that does not depend on 'param'. Classes that
+/// implement analyticalDerivative() should override this method as well.
+
+Bool_t RooAbsReal::hasAnalyticalDerivative(const RooAbsArg& param, const RooArgSet* /*normSet*/) const
+{
+  if (namePtr()==param.namePtr()) return kTRUE ;
+  return !dependsOnValue(param) ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the analytical derivative of getVal(normSet) with respect to 'param'
+/// at the current parameter values. The default implementation handles the
+/// trivial cases advertised by hasAnalyticalDerivative().
+
+Double_t RooAbsReal::analyticalDerivative(const RooAbsArg& param, const RooArgSet* /*normSet*/) const
+{
+  if (namePtr()==param.namePtr()) return 1 ;
+  if (dependsOnValue(param)) {
+    coutE(Eval) << "RooAbsReal::analyticalDerivative(" << GetName() << ") no analytical derivative implemented for parameter " 
+		<< param.GetName() << endl ;
+  }
+  return 0 ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return true if analyticalGradient() can calculate the derivatives of
+/// getVal() with respect to all elements of 'params'.
+
+Bool_t RooAbsReal::hasAnalyticalGradient(const RooArgList& params) const
+{
+  RooFIter iter = params.fwdIterator() ;
+  RooAbsArg* param ;
+  while((param=iter.next())) {
+    if (!hasAnalyticalDerivative(*param)) return kFALSE ;
+  }
+  return kTRUE ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Fill 'grad' with the derivatives of getVal() with respect to the elements
+/// of 'params', in the order of the list. Return false if the gradient could
+/// not be calculated. Classes that can compute all derivatives in one pass
+/// (e.g. likelihoods that loop over a dataset) should override this method.
+
+Bool_t RooAbsReal::analyticalGradient(const RooArgList& params, Double_t* grad) const
+{
+  RooFIter iter = params.fwdIterator() ;
+  RooAbsArg* param ;
+  Int_t i(0) ;
+  while((param=iter.next())) {
+    grad[i++] = analyticalDerivative(*param) ;
+  }
+  return kTRUE ;
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Get the label associated with the variable
 
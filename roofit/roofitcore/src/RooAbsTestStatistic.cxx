@@ -41,6 +41,7 @@ combined in the main thread.
 #include "RooAbsTestStatistic.h"
 #include "RooAbsPdf.h"
 #include "RooSimultaneous.h"
+#include "RooAbsCategory.h"
 #include "RooAbsData.h"
 #include "RooArgSet.h"
 #include "RooRealVar.h"
@@ -52,6 +53,7 @@ combined in the main thread.
 #include "RooProdPdf.h"
 #include "RooRealSumPdf.h"
 #include <string>
+#include <vector>
 
 using namespace std;
 
@@ -65,7 +67,7 @@ RooAbsTestStatistic::RooAbsTestStatistic() :
   _verbose(kFALSE), _init(kFALSE), _gofOpMode(Slave), _nEvents(0), _setNum(0),
   _numSets(0), _extSet(0), _nGof(0), _gofArray(0), _nCPU(1), _mpfeArray(0),
   _mpinterl(RooFit::BulkPartition), _doOffset(kFALSE), _offset(0),
-  _offsetCarry(0), _evalCarry(0)
+  _offsetCarry(0), _evalCarry(0), _gofCacheValid(kFALSE), _gofCacheHideOffset(kFALSE)
 {
 }
 
@@ -106,7 +108,9 @@ RooAbsTestStatistic::RooAbsTestStatistic(const char *name, const char *title, Ro
   _doOffset(kFALSE),
   _offset(0),
   _offsetCarry(0),
-  _evalCarry(0)
+  _evalCarry(0),
+  _gofCacheValid(kFALSE),
+  _gofCacheHideOffset(kFALSE)
 {
   // Register all parameters as servers
   RooArgSet* params = real.getParameters(&data) ;
@@ -165,7 +169,9 @@ RooAbsTestStatistic::RooAbsTestStatistic(const RooAbsTestStatistic& other, const
   _doOffset(other._doOffset),
   _offset(other._offset),
   _offsetCarry(other._offsetCarry),
-  _evalCarry(other._evalCarry)
+  _evalCarry(other._evalCarry),
+  _gofCacheValid(kFALSE),
+  _gofCacheHideOffset(kFALSE)
 {
   // Our parameters are those of original
   _paramSet.add(other._paramSet) ;
@@ -237,26 +243,8 @@ Double_t RooAbsTestStatistic::evaluate() const
   }
 
   if (SimMaster == _gofOpMode) {
-    // Evaluate array of owned GOF objects
-    Double_t ret = 0.;
-
-    if (_mpinterl == RooFit::BulkPartition || _mpinterl == RooFit::Interleave ) {
-      ret = combinedValue((RooAbsReal**)_gofArray,_nGof);
-    } else {
-      Double_t sum = 0., carry = 0.;
-      for (Int_t i = 0 ; i < _nGof; ++i) {
-	if (i % _numSets == _setNum || (_mpinterl==RooFit::Hybrid && _gofSplitMode[i] != RooFit::SimComponents )) {
-	  Double_t y = _gofArray[i]->getValV();
-	  carry += _gofArray[i]->getCarry();
-	  y -= carry;
-	  const Double_t t = sum + y;
-	  carry = (t - sum) - y;
-	  sum = t;
-	}
-      }
-      ret = sum ;
-      _evalCarry = carry;
-    }
+    // Evaluate array of owned GOF objects, only recalculating those whose parameters changed
+    Double_t ret = sumSimComponents() ;
 
     // Only apply global normalization if SimMaster doesn't have MP master
     if (numSets()==1) {
@@ -331,6 +319,191 @@ Double_t RooAbsTestStatistic::evaluate() const
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Sum the values of the component test statistics in SimMaster mode.
+///
+/// The value and Kahan carry of each component are cached together with the
+/// values of the component's own parameters. A component is only recalculated
+/// if one of its parameters changed value since its last calculation, so that a
+/// change of a parameter that appears in a few channels of a large simultaneous
+/// fit only triggers the recalculation of those channels. This does not rely on
+/// the dirty state of the components, which is also raised by changes that do
+/// not affect their value. Changes of the configuration or data of the
+/// components invalidate the cache through clearSimComponentCache(). When
+/// dirty state propagation is inhibited, all components are recalculated.
+///
+/// The sum is always recomputed from the cached component values with
+/// compensated summation. Updating a running sum with differences would make
+/// the result depend on the history of parameter changes, which spoils the
+/// numerical derivatives calculated by MINUIT. As the cached values are summed
+/// here, combinedValue() is not used for the components of a RooSimultaneous.
+
+Double_t RooAbsTestStatistic::sumSimComponents() const
+{
+  if (_gofValue.size() != (UInt_t)_nGof || _gofCacheHideOffset != hideOffset()) {
+    _gofValue.assign(_nGof,0.) ;
+    _gofCarry.assign(_nGof,0.) ;
+    _gofParamValues.assign(_nGof,std::vector<Double_t>()) ;
+    _gofCacheValid = kFALSE ;
+    _gofCacheHideOffset = hideOffset() ;
+  }
+
+  const Bool_t allComponents = (_mpinterl == RooFit::BulkPartition || _mpinterl == RooFit::Interleave) ;
+
+  Double_t sum = 0., carry = 0.;
+  for (Int_t i = 0 ; i < _nGof; ++i) {
+    if (allComponents || i % _numSets == _setNum || (_mpinterl==RooFit::Hybrid && _gofSplitMode[i] != RooFit::SimComponents )) {
+      if (simComponentChanged(i) || !_gofCacheValid || inhibitDirty()) {
+	_gofValue[i] = _gofArray[i]->getValV() ;
+	_gofCarry[i] = _gofArray[i]->getCarry() ;
+      }
+      Double_t y = _gofValue[i];
+      carry += _gofCarry[i];
+      y -= carry;
+      const Double_t t = sum + y;
+      carry = (t - sum) - y;
+      sum = t;
+    }
+  }
+  _gofCacheValid = kTRUE ;
+  _evalCarry = carry;
+
+  return sum ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return true if any parameter of component test statistic i changed value
+/// since the last call, and store the current values. Parameters that are
+/// neither real-valued nor categories are always considered to have changed.
+
+Bool_t RooAbsTestStatistic::simComponentChanged(Int_t i) const
+{
+  std::vector<Double_t>& values = _gofParamValues[i] ;
+  const RooArgSet& params = _gofArray[i]->_paramSet ;
+  const Bool_t sizeChanged = (values.size() != (UInt_t)params.getSize()) ;
+  if (sizeChanged) {
+    values.assign(params.getSize(),0.) ;
+  }
+
+  Bool_t changed(sizeChanged) ;
+  RooFIter iter = params.fwdIterator() ;
+  RooAbsArg* param ;
+  for (Int_t k = 0 ; (param = iter.next()) ; ++k) {
+    Double_t value ;
+    if (RooAbsReal* real = dynamic_cast<RooAbsReal*>(param)) {
+      value = real->getVal() ;
+    } else if (RooAbsCategory* cat = dynamic_cast<RooAbsCategory*>(param)) {
+      value = cat->getIndex() ;
+    } else {
+      changed = kTRUE ;
+      continue ;
+    }
+    if (value != values[k]) {
+      values[k] = value ;
+      changed = kTRUE ;
+    }
+  }
+
+  return changed ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return true if the derivatives of the test statistic with respect to all
+/// elements of 'params' can be calculated analytically. This is supported
+/// for single-process calculations of test statistics that implement
+/// evaluateGradientPartition(), and for simultaneous test statistics whose
+/// components all support it. Multi-process calculations fall back to
+/// numerical derivatives.
+
+Bool_t RooAbsTestStatistic::hasAnalyticalGradient(const RooArgList& params) const
+{
+  if (!_init) {
+    const_cast<RooAbsTestStatistic*>(this)->initialize() ;
+  }
+
+  if (numSets()!=1) return kFALSE ;
+
+  if (SimMaster == _gofOpMode) {
+    for (Int_t i = 0 ; i < _nGof; ++i) {
+      if (!_gofArray[i]->hasAnalyticalGradient(params)) return kFALSE ;
+    }
+    return kTRUE ;
+  } else if (MPMaster == _gofOpMode) {
+    return kFALSE ;
+  }
+  return hasAnalyticalGradientPartition(params) ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Fill 'grad' with the derivatives of the test statistic with respect to
+/// the elements of 'params'. Slaves calculate all derivatives in a single
+/// pass over their data through evaluateGradientPartition(). The offset that
+/// may be subtracted from the value is constant and does not contribute.
+
+Bool_t RooAbsTestStatistic::analyticalGradient(const RooArgList& params, Double_t* grad) const
+{
+  if (!hasAnalyticalGradient(params)) return kFALSE ;
+
+  Int_t n = params.getSize() ;
+  if (SimMaster == _gofOpMode) {
+    std::vector<Double_t> compGrad(n) ;
+    for (Int_t k = 0 ; k < n ; ++k) grad[k] = 0 ;
+    for (Int_t i = 0 ; i < _nGof; ++i) {
+      _gofArray[i]->analyticalGradient(params,compGrad.data()) ;
+      for (Int_t k = 0 ; k < n ; ++k) grad[k] += compGrad[k] ;
+    }
+  } else {
+    evaluateGradientPartition(params,grad,0,_nEvents,1) ;
+  }
+
+  const Double_t norm = globalNormalization();
+  for (Int_t k = 0 ; k < n ; ++k) grad[k] /= norm ;
+  return kTRUE ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Single-parameter version of hasAnalyticalGradient()
+
+Bool_t RooAbsTestStatistic::hasAnalyticalDerivative(const RooAbsArg& param, const RooArgSet* /*normSet*/) const
+{
+  return hasAnalyticalGradient(RooArgList(param)) ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Single-parameter version of analyticalGradient()
+
+Double_t RooAbsTestStatistic::analyticalDerivative(const RooAbsArg& param, const RooArgSet* /*normSet*/) const
+{
+  Double_t deriv(0) ;
+  analyticalGradient(RooArgList(param),&deriv) ;
+  return deriv ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Calculate the derivatives of the test statistic over the given event range.
+/// Must be implemented by test statistics that advertise an analytical gradient
+/// in hasAnalyticalGradientPartition().
+
+void RooAbsTestStatistic::evaluateGradientPartition(const RooArgList& params, Double_t* grad, Int_t /*firstEvent*/, Int_t /*lastEvent*/, Int_t /*stepSize*/) const
+{
+  coutE(Eval) << "RooAbsTestStatistic::evaluateGradientPartition(" << GetName() << ") no analytical gradient implemented" << endl ;
+  for (Int_t k = 0 ; k < params.getSize() ; ++k) grad[k] = 0 ;
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// One-time initialization of the test statistic. Setup
 /// infrastructure for simultaneous p.d.f processing and/or
@@ -344,6 +517,7 @@ Bool_t RooAbsTestStatistic::initialize()
     initMPMode(_func,_data,_projDeps,_rangeName.size()?_rangeName.c_str():0,_addCoefRangeName.size()?_addCoefRangeName.c_str():0) ;
   } else if (SimMaster == _gofOpMode) {
     initSimMode((RooSimultaneous*)_func,_data,_projDeps,_rangeName.size()?_rangeName.c_str():0,_addCoefRangeName.size()?_addCoefRangeName.c_str():0) ;
+    clearSimComponentCache() ;
   }
   _init = kTRUE;
   return kFALSE;
@@ -356,6 +530,7 @@ Bool_t RooAbsTestStatistic::initialize()
 
 Bool_t RooAbsTestStatistic::redirectServersHook(const RooAbsCollection& newServerList, Bool_t mustReplaceAll, Bool_t nameChange, Bool_t)
 {
+  clearSimComponentCache() ;
   if (SimMaster == _gofOpMode && _gofArray) {
     // Forward to slaves
     for (Int_t i = 0; i < _nGof; ++i) {
@@ -408,6 +583,7 @@ void RooAbsTestStatistic::printCompactTreeHook(ostream& os, const char* indent)
 void RooAbsTestStatistic::constOptimizeTestStatistic(ConstOpCode opcode, Bool_t doAlsoTrackingOpt)
 {
   initialize();
+  clearSimComponentCache() ;
   if (SimMaster == _gofOpMode) {
     // Forward to slaves
     for (Int_t i = 0; i < _nGof; ++i) {
@@ -432,6 +608,7 @@ void RooAbsTestStatistic::constOptimizeTestStatistic(ConstOpCode opcode, Bool_t
 void RooAbsTestStatistic::setMPSet(Int_t inSetNum, Int_t inNumSets)
 {
   _setNum = inSetNum; _numSets = inNumSets;
+  clearSimComponentCache() ;
   _extSet = _mpinterl==RooFit::SimComponents ? _setNum : (_numSets - 1);
   
   if (SimMaster == _gofOpMode) {
@@ -621,6 +798,8 @@ Bool_t RooAbsTestStatistic::setData(RooAbsData& indata, Bool_t cloneData)
     enableOffsetting(kTRUE);
   }
 
+  clearSimComponentCache() ;
+
   switch(operMode()) {
   case Slave:
     // Delegate to implementation
@@ -687,12 +866,16 @@ void RooAbsTestStatistic::enableOffsetting(Bool_t flag)
     for (Int_t i = 0; i < _nGof; ++i) {
       _gofArray[i]->enableOffsetting(flag);
     }
+    // Components are not servers of the master, propagate their change of value explicitly
+    clearSimComponentCache() ;
+    setValueDirty() ;
     break ;
   case MPMaster:    
     _doOffset = flag;
     for (Int_t i = 0; i < _nCPU; ++i) {
       _mpfeArray[i]->enableOffsetting(flag);
     }
+    setValueDirty() ;
     break;
   }
 }
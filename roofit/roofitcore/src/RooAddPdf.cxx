@@ -860,6 +860,91 @@ Double_t RooAddPdf::evaluate() const
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return true if the derivative of getVal(nset) with respect to 'param' can
+/// be calculated analytically. This is supported for sums with plain fraction
+/// or yield coefficients whose components and coefficients all provide an
+/// analytical derivative. Sums that require coefficient projection,
+/// a reference normalization range or supplemental normalization terms
+/// are not supported.
+
+Bool_t RooAddPdf::hasAnalyticalDerivative(const RooAbsArg& param, const RooArgSet* nset) const
+{
+  if (!dependsOnValue(param)) return kTRUE ;
+  if (_allExtendable || _projectCoefs || _normRange.Length()>0 || _refCoefNorm.getSize()>0) return kFALSE ;
+
+  CacheElem* cache = getProjCache(nset) ;
+  if (cache->_needSupNorm) return kFALSE ;
+
+  RooFIter pi = _pdfList.fwdIterator() ;
+  RooAbsPdf* pdf ;
+  while((pdf=(RooAbsPdf*)pi.next())) {
+    if (!pdf->hasAnalyticalDerivative(param,nset)) return kFALSE ;
+  }
+  RooFIter ci = _coefList.fwdIterator() ;
+  RooAbsReal* coef ;
+  while((coef=(RooAbsReal*)ci.next())) {
+    if (!coef->hasAnalyticalDerivative(param,nset)) return kFALSE ;
+  }
+  return kTRUE ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the analytical derivative of getVal(nset) with respect to 'param'
+/// for the configurations accepted by hasAnalyticalDerivative()
+
+Double_t RooAddPdf::analyticalDerivative(const RooAbsArg& param, const RooArgSet* nset) const
+{
+  if (!dependsOnValue(param)) return 0 ;
+
+  RooFIter pi = _pdfList.fwdIterator() ;
+  RooFIter ci = _coefList.fwdIterator() ;
+  RooAbsPdf* pdf ;
+  RooAbsReal* coef ;
+
+  if (_haveLastCoef) {
+
+    // value = SUM(coef[i]*pdf[i]) / SUM(coef)
+    Double_t num(0), dnum(0), coefSum(0), dcoefSum(0) ;
+    while((pdf=(RooAbsPdf*)pi.next())) {
+      coef = (RooAbsReal*)ci.next() ;
+      Double_t c = coef->getVal(nset) ;
+      Double_t dc = coef->analyticalDerivative(param,nset) ;
+      coefSum += c ;
+      dcoefSum += dc ;
+      if (pdf->isSelectedComp()) {
+	Double_t p = pdf->getVal(nset) ;
+	num += c*p ;
+	dnum += dc*p + c*pdf->analyticalDerivative(param,nset) ;
+      }
+    }
+    if (coefSum==0.) return 0 ;
+    return (dnum*coefSum - num*dcoefSum) / (coefSum*coefSum) ;
+  }
+
+  // value = SUM(coef[i]*pdf[i]) + (1-SUM(coef))*pdf[n]
+  Double_t deriv(0), lastCoef(1), dlastCoef(0) ;
+  while((coef=(RooAbsReal*)ci.next())) {
+    pdf = (RooAbsPdf*)pi.next() ;
+    Double_t c = coef->getVal(nset) ;
+    Double_t dc = coef->analyticalDerivative(param,nset) ;
+    lastCoef -= c ;
+    dlastCoef -= dc ;
+    if (pdf->isSelectedComp()) {
+      deriv += dc*pdf->getVal(nset) + c*pdf->analyticalDerivative(param,nset) ;
+    }
+  }
+  pdf = (RooAbsPdf*)pi.next() ;
+  if (pdf && pdf->isSelectedComp()) {
+    deriv += dlastCoef*pdf->getVal(nset) + lastCoef*pdf->analyticalDerivative(param,nset) ;
+  }
+  return deriv ;
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Reset error counter to given value, limiting the number
 /// of future error messages for this pdf to 'resetValue'
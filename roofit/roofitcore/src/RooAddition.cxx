@@ -41,6 +41,7 @@ i.e. all integrals of the product are handled numerically
 
 #include <algorithm>
 #include <cmath>
+#include <vector>
 
 using namespace std;
 
@@ -178,6 +179,73 @@ Double_t RooAddition::evaluate() const
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// The sum has an analytical derivative if all its terms have one
+
+Bool_t RooAddition::hasAnalyticalDerivative(const RooAbsArg& param, const RooArgSet* normSet) const
+{
+  RooFIter setIter = _set.fwdIterator() ;
+  RooAbsReal* comp ;
+  while((comp=(RooAbsReal*)setIter.next())) {
+    if (!comp->hasAnalyticalDerivative(param,normSet)) return kFALSE ;
+  }
+  return kTRUE ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the sum of the analytical derivatives of all terms
+
+Double_t RooAddition::analyticalDerivative(const RooAbsArg& param, const RooArgSet* normSet) const
+{
+  Double_t sum(0) ;
+  RooFIter setIter = _set.fwdIterator() ;
+  RooAbsReal* comp ;
+  while((comp=(RooAbsReal*)setIter.next())) {
+    sum += comp->analyticalDerivative(param,normSet) ;
+  }
+  return sum ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// The sum has an analytical gradient if all its terms have one
+
+Bool_t RooAddition::hasAnalyticalGradient(const RooArgList& params) const
+{
+  RooFIter setIter = _set.fwdIterator() ;
+  RooAbsReal* comp ;
+  while((comp=(RooAbsReal*)setIter.next())) {
+    if (!comp->hasAnalyticalGradient(params)) return kFALSE ;
+  }
+  return kTRUE ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Sum the gradients of all terms. Terms are asked for their full gradient
+/// so that likelihood terms can calculate it in a single pass over their data.
+
+Bool_t RooAddition::analyticalGradient(const RooArgList& params, Double_t* grad) const
+{
+  Int_t n = params.getSize() ;
+  std::vector<Double_t> compGrad(n) ;
+  for (Int_t i=0 ; i<n ; i++) grad[i] = 0 ;
+
+  RooFIter setIter = _set.fwdIterator() ;
+  RooAbsReal* comp ;
+  while((comp=(RooAbsReal*)setIter.next())) {
+    if (!comp->analyticalGradient(params,compGrad.data())) return kFALSE ;
+    for (Int_t i=0 ; i<n ; i++) grad[i] += compGrad[i] ;
+  }
+  return kTRUE ;
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return the default error level for MINUIT error analysis
 /// If the addition contains one or more RooNLLVars and 
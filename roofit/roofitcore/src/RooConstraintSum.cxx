@@ -129,3 +129,38 @@ Double_t RooConstraintSum::evaluate() const
   return sum ;
 }
 
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// The constraint sum has an analytical derivative if all constraint terms
+/// have one when normalized over the constrained parameters
+
+Bool_t RooConstraintSum::hasAnalyticalDerivative(const RooAbsArg& param, const RooArgSet* /*normSet*/) const
+{
+  RooFIter setIter1 = _set1.fwdIterator() ;
+  RooAbsReal* comp ;
+  while((comp=(RooAbsReal*)setIter1.next())) {
+    if (!comp->hasAnalyticalDerivative(param,&_paramSet)) return kFALSE ;
+  }
+  return kTRUE ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the derivative of -sum(log(constraint)) with respect to 'param'
+
+Double_t RooConstraintSum::analyticalDerivative(const RooAbsArg& param, const RooArgSet* /*normSet*/) const
+{
+  Double_t sum(0) ;
+  RooFIter setIter1 = _set1.fwdIterator() ;
+  RooAbsReal* comp ;
+  while((comp=(RooAbsReal*)setIter1.next())) {
+    Double_t deriv = comp->analyticalDerivative(param,&_paramSet) ;
+    if (deriv!=0) {
+      sum -= deriv / comp->getVal(&_paramSet) ;
+    }
+  }
+  return sum ;
+}
+
@@ -801,6 +801,8 @@ void RooDataHist::initialize(const char* binningName, Bool_t fillTree)
     _lvbins.push_back(binning ? binning->clone() : 0);
   }
 
+  initFastIndex() ;
+
   
   // Allocate coefficients array
   _idxMult.resize(_vars.getSize()) ;
@@ -931,6 +933,7 @@ RooDataHist::RooDataHist(const RooDataHist& other, const char* newname) :
     const RooAbsBinning* binning = dynamic_cast<RooAbsLValue*>(rvarg)->getBinningPtr(0) ;
     _lvbins.push_back(binning ? binning->clone() : 0) ;    
   }
+  initFastIndex() ;
 
   _dstore->setExternalWeightArray(_wgt,_errLo,_errHi,_sumw2) ;
 
@@ -1096,25 +1099,109 @@ Int_t RooDataHist::getIndex(const RooArgSet& coord, Bool_t fast)
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Cache the information needed for the fast index calculation of dimensions
+/// with a uniform binning: the real-valued observable, the lower bound and the
+/// width and number of bins. Dimensions with a non-uniform binning or a discrete
+/// observable are marked with a null observable pointer and use the generic
+/// RooAbsLValue::getBin() path.
+
+void RooDataHist::initFastIndex()
+{
+  const UInt_t nDim = _lvvars.size() ;
+  _lvreals.assign(nDim,0) ;
+  _lvxlo.assign(nDim,0.) ;
+  _lvbinw.assign(nDim,1.) ;
+  _lvnbins.assign(nDim,1) ;
+
+  for (UInt_t i=0 ; i<nDim ; i++) {
+    const RooAbsBinning* binning = _lvbins[i] ;
+    if (!binning || !binning->isUniform() || binning->numBins()<1) continue ;
+    _lvreals[i] = dynamic_cast<const RooAbsReal*>(_lvvars[i]) ;
+    _lvxlo[i] = binning->lowBound() ;
+    _lvbinw[i] = binning->averageBinWidth() ;
+    _lvnbins[i] = binning->numBins() ;
+  }
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Calculate the index for the weights array corresponding to 
 /// to the bin enclosing the current coordinates of the internal argset
 
 Int_t RooDataHist::calcTreeIndex() const 
 {
-  Int_t masterIdx(0), i(0) ;
-  vector<RooAbsLValue*>::const_iterator iter = _lvvars.begin() ;
-  vector<const RooAbsBinning*>::const_iterator biter = _lvbins.begin() ;
-  for (;iter!=_lvvars.end() ; ++iter) {
-    const RooAbsBinning* binning = (*biter) ;
-    masterIdx += _idxMult[i++]*(*iter)->getBin(binning) ;
-    ++biter ;
+  Int_t masterIdx(0) ;
+  const UInt_t nDim = _lvvars.size() ;
+  for (UInt_t i=0 ; i<nDim ; i++) {
+    const RooAbsReal* real = _lvreals[i] ;
+    if (real) {
+      // Uniform binning: same arithmetic as RooUniformBinning::binNumber(), without virtual calls
+      Int_t bin = Int_t((real->getVal() - _lvxlo[i])/_lvbinw[i]) ;
+      if (bin<0) bin = 0 ;
+      if (bin>_lvnbins[i]-1) bin = _lvnbins[i]-1 ;
+      masterIdx += _idxMult[i]*bin ;
+    } else {
+      masterIdx += _idxMult[i]*_lvvars[i]->getBin(_lvbins[i]) ;
+    }
   }
   return masterIdx ;
 }
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Retrieve the weights of the bins enclosing n points in one call, without
+/// changing the current coordinates of the dataset. The coordinates are passed
+/// per dimension: coords[j][i] is the value of the j-th observable of get() for
+/// point i. This is equivalent to calling weight(bin,0,correctForBinSize) for
+/// each point, i.e. no interpolation is performed. Only histograms with
+/// exclusively real-valued observables are supported; kFALSE is returned
+/// (and output is left untouched) otherwise.
+
+Bool_t RooDataHist::weights(Double_t* output, Int_t n, const Double_t* const* coords, Bool_t correctForBinSize) const
+{
+  checkInit() ;
+
+  const UInt_t nDim = _lvvars.size() ;
+  for (UInt_t j=0 ; j<nDim ; j++) {
+    if (!_lvbins[j]) {
+      coutE(InputArguments) << "RooDataHist::weights(" << GetName() << ") ERROR: batch weight lookup "
+			    << "is only supported for real-valued observables" << endl ;
+      return kFALSE ;
+    }
+  }
+
+  std::vector<Int_t> idx(n,0) ;
+  for (UInt_t j=0 ; j<nDim ; j++) {
+    const Double_t* x = coords[j] ;
+    const Int_t mult = _idxMult[j] ;
+    if (_lvreals[j]) {
+      const Double_t xlo = _lvxlo[j] ;
+      const Double_t binw = _lvbinw[j] ;
+      const Int_t nbins = _lvnbins[j] ;
+      for (Int_t i=0 ; i<n ; i++) {
+	Int_t bin = Int_t((x[i] - xlo)/binw) ;
+	bin = bin<0 ? 0 : (bin>nbins-1 ? nbins-1 : bin) ;
+	idx[i] += mult*bin ;
+      }
+    } else {
+      const RooAbsBinning* binning = _lvbins[j] ;
+      for (Int_t i=0 ; i<n ; i++) {
+	idx[i] += mult*binning->binNumber(x[i]) ;
+      }
+    }
+  }
+
+  for (Int_t i=0 ; i<n ; i++) {
+    output[i] = correctForBinSize ? get_wgt(idx[i]) / _binv[idx[i]] : get_wgt(idx[i]) ;
+  }
+  return kTRUE ;
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Debug stuff, should go...
 
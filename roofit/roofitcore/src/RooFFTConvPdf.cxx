@@ -127,6 +127,7 @@
 #include "RooGlobalFunc.h"
 #include "RooLinearVar.h"
 #include "RooConstVar.h"
+#include "RooAbsCategory.h"
 #include "TClass.h"
 #include "TSystem.h"
 
@@ -281,7 +282,8 @@ RooFFTConvPdf::PdfCacheElem* RooFFTConvPdf::createCache(const RooArgSet* nset) c
 
 RooFFTConvPdf::FFTCacheElem::FFTCacheElem(const RooFFTConvPdf& self, const RooArgSet* nsetIn) : 
   PdfCacheElem(self,nsetIn),
-  fftr2c1(0),fftr2c2(0),fftc2r(0) 
+  fftr2c1(0),fftr2c2(0),fftc2r(0),
+  rescan1(kTRUE),rescan2(kTRUE),nSlices(0),N(0),N2(0),binShift1(0)
 {
   RooAbsPdf* clonePdf1 = (RooAbsPdf*) self._pdf1.arg().cloneTree() ;
   RooAbsPdf* clonePdf2 = (RooAbsPdf*) self._pdf2.arg().cloneTree() ;
@@ -416,6 +418,38 @@ RooFFTConvPdf::FFTCacheElem::~FFTCacheElem()
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return kTRUE if any parameter of input p.d.f. i (1 or 2) changed value since
+/// its Fourier transforms were last calculated, and record the current values
+
+Bool_t RooFFTConvPdf::FFTCacheElem::inputChanged(Int_t i) 
+{
+  RooArgSet* params = ((i==1) ? pdf1Clone : pdf2Clone)->getParameters(*hist()->get()) ;
+  std::vector<Double_t>& vals = (i==1) ? paramVals1 : paramVals2 ;
+
+  std::vector<Double_t> cur ;
+  cur.reserve(params->getSize()) ;
+  RooFIter iter = params->fwdIterator() ;
+  RooAbsArg* arg ;
+  while ((arg=iter.next())) {
+    RooAbsReal* real = dynamic_cast<RooAbsReal*>(arg) ;
+    if (real) {
+      cur.push_back(real->getVal()) ;
+    } else {
+      RooAbsCategory* cat = dynamic_cast<RooAbsCategory*>(arg) ;
+      if (cat) cur.push_back(cat->getIndex()) ;
+    }
+  }
+
+  delete params ;
+
+  Bool_t changed = (cur!=vals) ;
+  vals.swap(cur) ;
+  return changed ;
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Fill the contents of the cache the FFT convolution output
 
@@ -438,9 +472,28 @@ void RooFFTConvPdf::fillCacheObject(RooAbsCachedPdf::PdfCacheElem& cache) const
 
   //cout << "RooFFTConvPdf::fillCacheObject() otherObs = " << otherObs << endl ;
 
+  // Only sample and transform the input p.d.f.s whose parameters changed,
+  // e.g. a change of resolution parameters leaves the physics p.d.f. transforms valid
+  FFTCacheElem& aux = (FFTCacheElem&) cache ;
+  Int_t nSlices(1) ;
+  RooFIter siter = otherObs.fwdIterator() ;
+  RooAbsArg* sarg ;
+  while ((sarg=siter.next())) {
+    RooAbsLValue* lvarg = dynamic_cast<RooAbsLValue*>(sarg) ;
+    if (lvarg) nSlices *= lvarg->numBins(binningName()) ;
+  }
+  Bool_t sameSlices = (aux.nSlices==nSlices) ;
+  aux.rescan1 = aux.inputChanged(1) || !sameSlices ;
+  aux.rescan2 = aux.inputChanged(2) || !sameSlices ;
+  if (!sameSlices) {
+    aux.spectrum1.clear() ;
+    aux.spectrum2.clear() ;
+  }
+  aux.nSlices = nSlices ;
+
   // Handle trivial scenario -- no other observables
   if (otherObs.getSize()==0) {
-    fillCacheSlice((FFTCacheElem&)cache,RooArgSet()) ;
+    fillCacheSlice(aux,RooArgSet()) ;
     return ;
   }
 
@@ -467,6 +520,7 @@ void RooFFTConvPdf::fillCacheObject(RooAbsCachedPdf::PdfCacheElem& cache) const
   }
   delete iter ;
 
+  Int_t sliceIdx(0) ;
   Bool_t loop(kTRUE) ;
   while(loop) {
     // Set current slice position
@@ -475,7 +529,7 @@ void RooFFTConvPdf::fillCacheObject(RooAbsCachedPdf::PdfCacheElem& cache) const
 //     cout << "filling slice: bin of obsLV[0] = " << obsLV[0]->getBin() << endl ;
 
     // Fill current slice
-    fillCacheSlice((FFTCacheElem&)cache,otherObs) ;
+    fillCacheSlice(aux,otherObs,sliceIdx++) ;
 
     // Determine which iterator to increment
     while(binCur[curObs]==binMax[curObs]) {
@@ -505,9 +559,12 @@ void RooFFTConvPdf::fillCacheObject(RooAbsCachedPdf::PdfCacheElem& cache) const
 
 
 ////////////////////////////////////////////////////////////////////////////////
-/// Fill a slice of cachePdf with the output of the FFT convolution calculation
+/// Fill a slice of cachePdf with the output of the FFT convolution calculation.
+/// Only the inputs flagged for rescanning in the cache element are sampled and
+/// transformed, the Fourier transforms of the other input are taken from the
+/// previous fill of slice sliceIdx.
 
-void RooFFTConvPdf::fillCacheSlice(FFTCacheElem& aux, const RooArgSet& slicePos) const 
+void RooFFTConvPdf::fillCacheSlice(FFTCacheElem& aux, const RooArgSet& slicePos, Int_t sliceIdx) const 
 {
   // Extract histogram that is the basis of the RooHistPdf
   RooDataHist& cacheHist = *aux.hist() ;
@@ -527,11 +584,19 @@ void RooFFTConvPdf::fillCacheSlice(FFTCacheElem& aux, const RooArgSet& slicePos)
   
   RooRealVar* histX = (RooRealVar*) cacheHist.get()->find(_x.arg().GetName()) ;
   if (_bufStrat==Extend) histX->setBinning(*aux.scanBinning) ;
-  Double_t* input1 = scanPdf((RooRealVar&)_x.arg(),*aux.pdf1Clone,cacheHist,slicePos,N,N2,binShift1,_shift1) ;
-  Double_t* input2 = scanPdf((RooRealVar&)_x.arg(),*aux.pdf2Clone,cacheHist,slicePos,N,N2,binShift2,_shift2) ;
+  Double_t* input1 = aux.rescan1 ? scanPdf((RooRealVar&)_x.arg(),*aux.pdf1Clone,cacheHist,slicePos,N,N2,binShift1,_shift1) : 0 ;
+  Double_t* input2 = aux.rescan2 ? scanPdf((RooRealVar&)_x.arg(),*aux.pdf2Clone,cacheHist,slicePos,N,N2,binShift2,_shift2) : 0 ;
   if (_bufStrat==Extend) histX->setBinning(*aux.histBinning) ;
 
-
+  // Sampling geometry does not depend on the p.d.f. values 
+  if (input1) aux.binShift1 = binShift1 ;
+  if (input1 || input2) {
+    aux.N = N ;
+    aux.N2 = N2 ;
+  }
+  N = aux.N ;
+  N2 = aux.N2 ;
+  binShift1 = aux.binShift1 ;
 
 
   // Retrieve previously defined FFT transformation plans
@@ -540,21 +605,39 @@ void RooFFTConvPdf::fillCacheSlice(FFTCacheElem& aux, const RooArgSet& slicePos)
     aux.fftr2c2 = TVirtualFFT::FFT(1, &N2, "R2CK");
     aux.fftc2r  = TVirtualFFT::FFT(1, &N2, "C2RK");
   }
+
+  const Int_t nc = N2/2+1 ;
+  const std::size_t offset = 2*std::size_t(nc)*sliceIdx ;
+  if (aux.spectrum1.size()<offset+2*nc) {
+    aux.spectrum1.resize(offset+2*nc) ;
+    aux.spectrum2.resize(offset+2*nc) ;
+  }
+  Double_t* spec1 = &aux.spectrum1[offset] ;
+  Double_t* spec2 = &aux.spectrum2[offset] ;
   
   // Real->Complex FFT Transform on p.d.f. 1 sampling
-  aux.fftr2c1->SetPoints(input1);
-  aux.fftr2c1->Transform();
+  if (input1) {
+    aux.fftr2c1->SetPoints(input1);
+    aux.fftr2c1->Transform();
+    for (Int_t i=0 ; i<nc ; i++) {
+      aux.fftr2c1->GetPointComplex(i,spec1[2*i],spec1[2*i+1]) ;
+    }
+  }
 
   // Real->Complex FFT Transform on p.d.f 2 sampling
-  aux.fftr2c2->SetPoints(input2);
-  aux.fftr2c2->Transform();
+  if (input2) {
+    aux.fftr2c2->SetPoints(input2);
+    aux.fftr2c2->Transform();
+    for (Int_t i=0 ; i<nc ; i++) {
+      aux.fftr2c2->GetPointComplex(i,spec2[2*i],spec2[2*i+1]) ;
+    }
+  }
 
   // Loop over first half +1 of complex output results, multiply 
   // and set as input of reverse transform
-  for (Int_t i=0 ; i<N2/2+1 ; i++) {
-    Double_t re1,re2,im1,im2 ;
-    aux.fftr2c1->GetPointComplex(i,re1,im1) ;
-    aux.fftr2c2->GetPointComplex(i,re2,im2) ;
+  for (Int_t i=0 ; i<nc ; i++) {
+    Double_t re1 = spec1[2*i], im1 = spec1[2*i+1] ;
+    Double_t re2 = spec2[2*i], im2 = spec2[2*i+1] ;
     Double_t re = re1*re2 - im1*im2 ;
     Double_t im = re1*im2 + re2*im1 ;
     TComplex t(re,im) ;
@@ -19,23 +19,27 @@
 \class RooFormula
 \ingroup Roofitcore
 
-RooFormula an implementation of ROOT::v5::TFormula that interfaces it to RooAbsArg
+RooFormula interfaces the JIT-compiled TFormula to RooAbsArg
 value objects. It allows to use the value of a given list of RooAbsArg objects in the formula
 expression. Reference is done either by the RooAbsArgs name
 or by list ordinal postion ('@0,@1,...'). State information
 of RooAbsCategories can be accessed used the '::' operator,
 e.g. 'tagCat::Kaon' will resolve to the numerical value of
 the 'Kaon' state of the RooAbsCategory object named tagCat.
+
+All references are translated into the TFormula variables x[0],x[1],...
+before compilation, such that each evaluation fills one array with the
+current values of the used dependents and calls the compiled function.
 **/
 
 #include "RooFit.h"
 
-#include "Riostream.h"
 #include "Riostream.h"
 #include <stdlib.h>
+#include <cctype>
 #include "TROOT.h"
 #include "TClass.h"
-#include "TObjString.h"
+#include "TBuffer.h"
 #include "RooFormula.h"
 #include "RooAbsReal.h"
 #include "RooAbsCategory.h"
@@ -52,7 +56,7 @@ ClassImp(RooFormula);
 /// Default constructor
 /// coverity[UNINIT_CTOR]
 
-RooFormula::RooFormula() : ROOT::v5::TFormula(), _nset(0)
+RooFormula::RooFormula() : TNamed(), _nset(0), _isOK(kFALSE), _compiled(kFALSE)
 {
 }
 
@@ -61,17 +65,13 @@ RooFormula::RooFormula() : ROOT::v5::TFormula(), _nset(0)
 /// Constructor with expression string and list of RooAbsArg variables
 
 RooFormula::RooFormula(const char* name, const char* formula, const RooArgList& list) : 
-  ROOT::v5::TFormula(), _isOK(kTRUE), _compiled(kFALSE)
+  TNamed(name,formula), _nset(0), _isOK(kTRUE), _compiled(kFALSE)
 {
-  SetName(name) ;
-  SetTitle(formula) ;
-
-  TIterator* iter = list.createIterator() ;
+  RooFIter iter = list.fwdIterator() ;
   RooAbsArg* arg ;
-  while ((arg=(RooAbsArg*)iter->Next())) {
+  while ((arg=iter.next())) {
     _origList.Add(arg) ;
   }
-  delete iter ;
 
   _compiled = kTRUE ;
   if (Compile()) {
@@ -84,20 +84,18 @@ RooFormula::RooFormula(const char* name, const char* formula, const RooArgList&
 
 
 ////////////////////////////////////////////////////////////////////////////////
-/// Copy constructor
+/// Copy constructor. The expression is reprocessed against the copied
+/// list of dependents; TFormula reuses the function that cling already
+/// JIT-compiled for an identical expression.
 
 RooFormula::RooFormula(const RooFormula& other, const char* name) : 
-  ROOT::v5::TFormula(), RooPrintable(other), _isOK(other._isOK), _compiled(kFALSE) 
+  TNamed(name?name:other.GetName(),other.GetTitle()), RooPrintable(other), _nset(0), _isOK(other._isOK), _compiled(kFALSE) 
 {
-  SetName(name?name:other.GetName()) ;
-  SetTitle(other.GetTitle()) ;
-
-  TIterator* iter = other._origList.MakeIterator() ;
+  RooFIter iter = other._origList.fwdIterator() ;
   RooAbsArg* arg ;
-  while ((arg=(RooAbsArg*)iter->Next())) {
+  while ((arg=iter.next())) {
     _origList.Add(arg) ;
   }
-  delete iter ;
   
   Compile() ;
   _compiled=kTRUE ;
@@ -110,9 +108,6 @@ RooFormula::RooFormula(const RooFormula& other, const char* name) :
 
 Bool_t RooFormula::reCompile(const char* newFormula) 
 {
-  fNval=0 ;
-  _useList.Clear() ;  
-
   TString oldFormula=GetTitle() ;
   if (Compile(newFormula)) {
     coutE(InputArguments) << "RooFormula::reCompile: new equation doesn't compile, formula unchanged" << endl ;
@@ -131,7 +126,118 @@ Bool_t RooFormula::reCompile(const char* newFormula)
 
 RooFormula::~RooFormula() 
 {
-  _labelList.Delete() ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Translate the RooFit expression into a TFormula expression and compile it.
+/// If no expression is given, the title is used. Returns kTRUE on error.
+
+Bool_t RooFormula::Compile(const char* expression)
+{
+  _useList.Clear() ;
+  _useIsCat.clear() ;
+  _labelList.clear() ;
+  _tFormula.reset() ;
+
+  Bool_t ok(kTRUE) ;
+  std::string processed = processFormula(expression ? expression : GetTitle(), ok) ;
+  if (!ok) return kTRUE ;
+
+  // Do not register the internal formula in the global list of functions
+  std::unique_ptr<TFormula> tFormula(new TFormula(Form("%s_internal",GetName()),processed.c_str(),false)) ;
+  if (!tFormula->IsValid()) {
+    coutE(InputArguments) << "RooFormula::Compile(" << GetName() << ") ERROR: TFormula cannot compile '"
+			  << (expression ? expression : GetTitle()) << "', translated as '" << processed << "'" << endl ;
+    return kTRUE ;
+  }
+
+  _tFormula = std::move(tFormula) ;
+  _argValues.assign(_useList.GetSize(),0.) ;
+  return kFALSE ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Replace every reference to a RooAbsArg in the given expression, either by
+/// ordinal ('@N'), by name or by category state ('cat::label'), by the TFormula
+/// variable x[i], where i is the slot of the argument in _useList. Function
+/// calls, namespace members (e.g. TMath::Pi) and 'pi' are passed on unchanged,
+/// any other identifier that does not resolve to one of our dependents is an error.
+
+std::string RooFormula::processFormula(const char* expression, Bool_t& ok)
+{
+  const std::string expr(expression ? expression : "") ;
+  const std::size_t n = expr.size() ;
+  std::string out ;
+  out.reserve(n+16) ;
+
+  std::size_t i(0) ;
+  while (i<n) {
+    const char c = expr[i] ;
+
+    // Numeric literals, including exponents, are copied verbatim
+    if (isdigit(c) || (c=='.' && i+1<n && isdigit(expr[i+1]))) {
+      std::size_t j(i) ;
+      while (j<n && (isalnum(expr[j]) || expr[j]=='.')) {
+	if ((expr[j]=='e' || expr[j]=='E') && j+1<n && (expr[j+1]=='+' || expr[j+1]=='-')) j++ ;
+	j++ ;
+      }
+      out.append(expr,i,j-i) ;
+      i=j ;
+      continue ;
+    }
+
+    if (c!='@' && c!='_' && !isalpha(c)) {
+      out += c ;
+      i++ ;
+      continue ;
+    }
+
+    // Identifier, optionally followed by a '::label' qualifier
+    std::size_t j(i+1) ;
+    while (j<n && (isalnum(expr[j]) || expr[j]=='_')) j++ ;
+    if (j+2<n && expr[j]==':' && expr[j+1]==':' && (isalpha(expr[j+2]) || expr[j+2]=='_')) {
+      j+=2 ;
+      while (j<n && (isalnum(expr[j]) || expr[j]=='_')) j++ ;
+    }
+    TString token(expr.substr(i,j-i).c_str()) ;
+
+    // Members of a namespace (e.g. TMath::Erf) are never dependents
+    const Bool_t scoped = out.size()>=2 && out.compare(out.size()-2,2,"::")==0 ;
+    const Int_t code = scoped ? -1 : DefinedVariable(token) ;
+    if (code>=0) {
+      out += Form("x[%d]",code) ;
+    } else if (c=='@') {
+      coutE(InputArguments) << "RooFormula::processFormula(" << GetName() << ") ERROR: cannot resolve '"
+			    << token << "'" << endl ;
+      ok = kFALSE ;
+      out += token.Data() ;
+    } else if (code==-2) {
+      // Reference to a dependent with an invalid category label, reported by DefinedVariable
+      ok = kFALSE ;
+      out += token.Data() ;
+    } else {
+      // Anything else must be a function call, a namespace member or pi. TFormula would
+      // otherwise silently bind names such as 'e', 'c', 'g' or 'x' to its own constants
+      // and variables
+      std::size_t k(j) ;
+      while (k<n && isspace(expr[k])) k++ ;
+      const Bool_t isCall = k<n && expr[k]=='(' ;
+      const Bool_t isMember = scoped || token.Contains("::") ;
+      if (!isCall && !isMember && token!="pi") {
+	coutE(InputArguments) << "RooFormula::processFormula(" << GetName() << ") ERROR: '"
+			      << token << "' is not a dependent of this formula" << endl ;
+	ok = kFALSE ;
+      }
+      out += token.Data() ;
+    }
+    i=j ;
+  }
+
+  return out ;
 }
 
 
@@ -150,9 +256,10 @@ RooArgSet& RooFormula::actualDependents() const
 
   _actual.removeAll();
   
-  int i ;
-  for (i=0 ; i<_useList.GetSize() ; i++) {
-    _actual.add((RooAbsArg&)*_useList.At(i),kTRUE) ;
+  RooFIter iter = _useList.fwdIterator() ;
+  RooAbsArg* arg ;
+  while ((arg=iter.next())) {
+    _actual.add(*arg,kTRUE) ;
   }
 
   return _actual ;
@@ -172,13 +279,16 @@ void RooFormula::dump()
     cout << "[" << i << "] = " << (void*) _useList.At(i) << " " << _useList.At(i)->GetName() << endl ;
   }
   cout << "labelList:" << endl ;
-  for (i=0 ; i<_labelList.GetSize() ; i++) {
-    cout << "[" << i << "] = " << (void*) _labelList.At(i) << " " << _labelList.At(i)->GetName() <<  endl ;
+  for (i=0 ; i<(int)_labelList.size() ; i++) {
+    cout << "[" << i << "] = " << _labelList[i] <<  endl ;
   }
   cout << "origList:" << endl ;
   for (i=0 ; i<_origList.GetSize() ; i++) {
     cout << "[" << i << "] = " << (void*) _origList.At(i)  << " " << _origList.At(i)->GetName() <<  endl ;
   }
+  if (_tFormula) {
+    cout << "compiled expression: " << _tFormula->GetExpFormula() << endl ;
+  }
 }
 
 
@@ -228,8 +338,10 @@ Bool_t RooFormula::changeDependents(const RooAbsCollection& newDeps, Bool_t must
 
 
 ////////////////////////////////////////////////////////////////////////////////
-/// Evaluate ROOT::v5::TFormula using given normalization set to be used as
-/// observables definition passed to RooAbsReal::getVal()
+/// Evaluate the compiled TFormula using given normalization set to be used as
+/// observables definition passed to RooAbsReal::getVal(). The values of all
+/// used dependents are gathered in a single pass and handed to the compiled
+/// function as its argument array.
 
 Double_t RooFormula::eval(const RooArgSet* nset)
 { 
@@ -239,80 +351,41 @@ Double_t RooFormula::eval(const RooArgSet* nset)
   }
 
   // WVE sanity check should go here
-  if (!_isOK) {
+  if (!_isOK || !_tFormula) {
     coutE(Eval) << "RooFormula::eval(" << GetName() << "): Formula doesn't compile: " << GetTitle() << endl ;
     return 0. ;
   }
 
-  // Pass current dataset pointer to DefinedValue
   _nset = (RooArgSet*) nset ;
 
-  return EvalPar(0,0) ; 
-}
-
-
-Double_t
-
-////////////////////////////////////////////////////////////////////////////////
-/// Interface to ROOT::v5::TFormula, return value defined by object with id 'code'
-/// Object ids are mapped from object names by method DefinedVariable()
-
-RooFormula::DefinedValue(Int_t code) 
-{
-  // Return current value for variable indicated by internal reference code
-  if (code>=_useList.GetSize()) return 0 ;
-
-  RooAbsArg* arg=(RooAbsArg*)_useList.At(code) ;
-  if (_useIsCat[code]) {
-
-    // Process as category
-    const RooAbsCategory *absCat = (const RooAbsCategory*)(arg);
-    TString& label=((TObjString*)_labelList.At(code))->String() ;
-    if (label.IsNull()) {
-      return absCat->getIndex() ;
+  RooFIter iter = _useList.fwdIterator() ;
+  RooAbsArg* arg ;
+  std::size_t i(0) ;
+  while ((arg=iter.next())) {
+    if (_useIsCat[i]) {
+      // Process as category
+      const RooAbsCategory* absCat = static_cast<const RooAbsCategory*>(arg) ;
+      if (_labelList[i].empty()) {
+	_argValues[i] = absCat->getIndex() ;
+      } else {
+	_argValues[i] = absCat->lookupType(_labelList[i].c_str())->getVal() ;
+      }
     } else {
-      return absCat->lookupType(label)->getVal() ; // DK: why not call getVal(_nset) here also?
+      // Process as real
+      _argValues[i] = static_cast<const RooAbsReal*>(arg)->getVal(_nset) ;
     }
-
-  } else {
-
-    // Process as real 
-    const RooAbsReal *absReal= (const RooAbsReal*)(arg);  
-    return absReal->getVal(_nset) ;
-    
+    i++ ;
   }
 
-  return 0 ;
-}
-
-
-
-////////////////////////////////////////////////////////////////////////////////
-/// Interface to ROOT::v5::TFormula. If name passed by ROOT::v5::TFormula is recognized
-/// as one of our RooAbsArg servers, return a unique id integer
-/// that represent this variable.
-
-Int_t RooFormula::DefinedVariable(TString &name, int& action)
-{
-  Int_t ret = DefinedVariable(name) ;
-  if (ret>=0) {
-
-#if ROOT_VERSION_CODE >= ROOT_VERSION(4,0,1)
-     action = kDefinedVariable;
-#else
-     action = 0 ; // prevents compiler warning
-#endif
-
-  }
-  return ret ;
+  return _tFormula->EvalPar(_argValues.data()) ; 
 }
 
 
 
 ////////////////////////////////////////////////////////////////////////////////
-/// Interface to ROOT::v5::TFormula. If name passed by ROOT::v5::TFormula is recognized
-/// as one of our RooAbsArg servers, return a unique id integer
-/// that represent this variable.
+/// If name is recognized as one of our RooAbsArg servers, return a unique id
+/// integer that represent this variable. Return -2 if name refers to one of our
+/// servers with a '::label' that is not a valid category state, otherwise return -1.
 
 Int_t RooFormula::DefinedVariable(TString &name) 
 {
@@ -359,13 +432,13 @@ Int_t RooFormula::DefinedVariable(TString &name)
     if (!cat) {
       coutE(Eval) << "RooFormula::DefinedVariable(" << GetName() << ") ERROR: " 
 		  << arg->GetName() << "' is not a RooAbsCategory" << endl ;
-      return -1 ;
+      return -2 ;
     }
 
     if (!cat->lookupType(labelName)) {
       coutE(Eval) << "RooFormula::DefinedVariable(" << GetName() << ") ERROR '" 
 		  << labelName << "' is not a state of " << arg->GetName() << endl ;
-      return -1 ;
+      return -2 ;
     }
 
   }
@@ -379,11 +452,11 @@ Int_t RooFormula::DefinedVariable(TString &name)
     Bool_t varMatch = !TString(var->GetName()).CompareTo(arg->GetName()) && !TString(var->getStringAttribute("origName")).CompareTo(arg->GetName());
 
     if (varMatch) {
-      TString& lbl= ((TObjString*) _labelList.At(i))->String() ;
+      const std::string& lbl = _labelList[i] ;
       Bool_t lblMatch(kFALSE) ;
-      if (!labelName && lbl.IsNull()) {
+      if (!labelName && lbl.empty()) {
 	lblMatch=kTRUE ;
-      } else if (labelName && !lbl.CompareTo(labelName)) {
+      } else if (labelName && lbl==labelName) {
 	lblMatch=kTRUE ;
       }
 
@@ -397,11 +470,7 @@ Int_t RooFormula::DefinedVariable(TString &name)
   // Register new entry ;
   _useList.Add(arg) ;
   _useIsCat.push_back(dynamic_cast<RooAbsCategory*>(arg)) ;
-  if (!labelName) {
-    _labelList.Add(new TObjString("")) ;
-  } else {
-    _labelList.Add(new TObjString(labelName)) ;
-  }
+  _labelList.push_back(labelName ? labelName : "") ;
 
    return (_useList.GetSize()-1) ;
 }
@@ -463,3 +532,49 @@ void RooFormula::printArgs(ostream& os) const
 {
   os << "[ actualVars=" << _actual << " ]" ;
 }
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Custom streamer. Version 1 derived from ROOT::v5::TFormula, of which
+/// only the name and the expression are retained. The JIT-compiled formula
+/// is never persisted, it is rebuilt on first use after reading.
+
+void RooFormula::Streamer(TBuffer &R__b)
+{
+  if (R__b.IsReading()) {
+
+    UInt_t R__s, R__c;
+    Version_t R__v = R__b.ReadVersion(&R__s, &R__c);
+    switch (R__v) {
+      case 2:
+	R__b.ReadClassBuffer(RooFormula::Class(), this, R__v, R__s, R__c);
+	break;
+      case 1:
+	{
+	  // ROOT::v5::TFormula base: read its TNamed base and skip the rest
+	  UInt_t R__s1, R__c1;
+	  R__b.ReadVersion(&R__s1, &R__c1);
+	  TNamed::Streamer(R__b);
+	  R__b.SetBufferOffset(R__s1 + R__c1 + sizeof(UInt_t));
+
+	  RooPrintable::Streamer(R__b);
+	  // The persisted normalisation set is not needed and _nset is not owned: read it and drop it
+	  RooArgSet* nset = 0;
+	  R__b >> nset;
+	  delete nset;
+	  R__b >> _isOK;
+	  RooLinkedList labels;
+	  labels.Streamer(R__b);
+	  R__b >> _compiled;
+	}
+	R__b.CheckByteCount(R__s, R__c, RooFormula::IsA());
+	break;
+      default:
+	throw std::string("Unknown class version!");
+    }
+    _compiled = kFALSE;
+
+  } else {
+    R__b.WriteClassBuffer(RooFormula::Class(),this);
+  }
+}
@@ -62,6 +62,13 @@ These study modules should derive from classs RooAbsMCStudyModel
 #include "RooPullVar.h"
 #include "RooMsgService.h"
 #include "RooProdPdf.h"
+#include "TObjArray.h"
+#include "TMath.h"
+
+#ifndef _WIN32
+#include "ROOT/TProcessExecutor.hxx"
+#include "ROOT/TSeq.hxx"
+#endif
 
 using namespace std ;
 
@@ -150,6 +157,8 @@ RooMCStudy::RooMCStudy(const RooAbsPdf& model, const RooArgSet& observables,
   }
 
   // Decode command line arguments
+  _nWorkers = 1 ;
+  _toySeed = 0 ;
   _silence = pc.getInt("silence") ;
   _verboseGen = pc.getInt("verboseGen") ;
   _extendedGen = pc.getInt("extendedGen") ;
@@ -338,7 +347,9 @@ RooMCStudy::RooMCStudy(const RooAbsPdf& genModel, const RooAbsPdf& fitModel,
   _fitOptions(fitOptions),
   _canAddFitResults(kTRUE),
   _perExptGenParams(0),
-  _silence(kFALSE)
+  _silence(kFALSE),
+  _nWorkers(1),
+  _toySeed(0)
 {
   // Decode generator options
   TString genOpt(genOptions) ;
@@ -469,16 +480,75 @@ Bool_t RooMCStudy::run(Bool_t doGenerate, Bool_t DoFit, Int_t nSamples, Int_t nE
     (*iter)->initializeRun(nSamples) ;
   }  
   
+  // Run the samples, either in this process or distributed over forked workers
+  list<RooDataSet*> auxDataList ;
+  Bool_t ownAuxData = kFALSE ;
+  if (_nWorkers>1 && nSamples>1) {
+    ownAuxData = runParallel(doGenerate,DoFit,nSamples,nEvtPerSample,keepGenData,asciiFilePat,auxDataList) ;
+  } else {
+    runSamples(doGenerate,DoFit,0,nSamples,nEvtPerSample,keepGenData,asciiFilePat) ;
+    for (iter=_modList.begin() ; iter!= _modList.end() ; ++iter) {
+      auxDataList.push_back((*iter)->finalizeRun()) ;
+    }
+  }
+
+  for (list<RooDataSet*>::iterator aiter=auxDataList.begin() ; aiter!=auxDataList.end() ; ++aiter) {
+    if (*aiter) {
+      _fitParData->merge(*aiter) ;
+      if (ownAuxData) delete *aiter ;
+    }
+  }  
+
+  _canAddFitResults = kFALSE ;
+
+  if (_genParData) {
+    const RooArgSet* genPars = _genParData->get() ;
+    TIterator* iter2 = genPars->createIterator() ;
+    RooAbsArg* arg ;
+    while((arg=(RooAbsArg*)iter2->Next())) {
+      _genParData->changeObservableName(arg->GetName(),Form("%s_gen",arg->GetName())) ;
+    }
+    delete iter2 ;
+    
+    _fitParData->merge(_genParData) ;
+  }
+
+  if (DoFit) calcPulls() ;
+
+  if (_silence) {
+    RooMsgService::instance().setGlobalKillBelow(oldLevel) ;
+  }
+
+  return kFALSE ;
+}
+
+
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Generate and/or fit the samples numbered [firstSample,firstSample+nSamples),
+/// in descending order of the sample number. This is the event loop of run(),
+/// which is executed by the worker processes in a parallel run.
+
+void RooMCStudy::runSamples(Bool_t doGenerate, Bool_t DoFit, Int_t firstSample, Int_t nSamples, Int_t nEvtPerSample, Bool_t keepGenData, const char* asciiFilePat) 
+{
   Int_t prescale = nSamples>100 ? Int_t(nSamples/100) : 1 ;
 
-  while(nSamples--) {
+  for (Int_t isample=firstSample+nSamples-1 ; isample>=firstSample ; --isample) {
+
+    // Reseed the generator from the sample number if reproducible toys are requested
+    if (_toySeed) {
+      RooRandom::randomGenerator()->SetSeed(RooRandom::derivedSeed(_toySeed,isample)) ;
+    }
     
-    if (nSamples%prescale==0) {
+    if (isample%prescale==0) {
       oocoutP(_fitModel,Generation) << "RooMCStudy::run: " ;
       if (doGenerate) ooccoutI(_fitModel,Generation) << "Generating " ;
       if (doGenerate && DoFit) ooccoutI(_fitModel,Generation) << "and " ;
       if (DoFit) ooccoutI(_fitModel,Generation) << "fitting " ;
-      ooccoutP(_fitModel,Generation) << "sample " << nSamples << endl ;
+      ooccoutP(_fitModel,Generation) << "sample " << isample << endl ;
     }
 
     _genSample = 0;
@@ -505,7 +575,7 @@ Bool_t RooMCStudy::run(Bool_t doGenerate, Bool_t DoFit, Int_t nSamples, Int_t nE
       // Call module before-generation hook
       list<RooAbsMCStudyModule*>::iterator iter2 ;
       for (iter2=_modList.begin() ; iter2!= _modList.end() ; ++iter2) {
-	(*iter2)->processBeforeGen(nSamples) ;
+	(*iter2)->processBeforeGen(isample) ;
       }  
 
       if (_binGenData) {
@@ -552,17 +622,17 @@ Bool_t RooMCStudy::run(Bool_t doGenerate, Bool_t DoFit, Int_t nSamples, Int_t nE
 
       // Load sample from ASCII file
       char asciiFile[1024] ;
-      snprintf(asciiFile,1024,asciiFilePat,nSamples) ;
+      snprintf(asciiFile,1024,asciiFilePat,isample) ;
       RooArgList depList(_allDependents) ;
       _genSample = RooDataSet::read(asciiFile,depList,"q") ;      
       
     } else {
       
       // Load sample from internal list
-      _genSample = (RooDataSet*) _genDataList.At(nSamples) ;
+      _genSample = (RooDataSet*) _genDataList.At(isample) ;
       existingData = kTRUE ;
       if (!_genSample) {
-   	oocoutW(_fitModel,Generation) << "RooMCStudy::run: WARNING: Sample #" << nSamples << " not loaded, skipping" << endl ;
+   	oocoutW(_fitModel,Generation) << "RooMCStudy::run: WARNING: Sample #" << isample << " not loaded, skipping" << endl ;
    	continue ;
       }
     }
@@ -573,20 +643,20 @@ Bool_t RooMCStudy::run(Bool_t doGenerate, Bool_t DoFit, Int_t nSamples, Int_t nE
     // Call module between generation and fitting hook
     list<RooAbsMCStudyModule*>::iterator iter3 ;
     for (iter3=_modList.begin() ; iter3!= _modList.end() ; ++iter3) {
-      (*iter3)->processBetweenGenAndFit(nSamples) ;
+      (*iter3)->processBetweenGenAndFit(isample) ;
     }  
     
     if (DoFit) fitSample(_genSample) ;
 
     // Call module between generation and fitting hook
     for (iter3=_modList.begin() ; iter3!= _modList.end() ; ++iter3) {
-      (*iter3)->processAfterFit(nSamples) ;
+      (*iter3)->processAfterFit(isample) ;
     }  
     
     // Optionally write to ascii file
     if (doGenerate && asciiFilePat && *asciiFilePat) {
       char asciiFile[1024] ;
-      snprintf(asciiFile,1024,asciiFilePat,nSamples) ;
+      snprintf(asciiFile,1024,asciiFilePat,isample) ;
       RooDataSet* unbinnedData = dynamic_cast<RooDataSet*>(_genSample) ;
       if (unbinnedData) {
 	unbinnedData->write(asciiFile) ;
@@ -605,38 +675,158 @@ Bool_t RooMCStudy::run(Bool_t doGenerate, Bool_t DoFit, Int_t nSamples, Int_t nE
     }
   }
 
-  for (iter=_modList.begin() ; iter!= _modList.end() ; ++iter) {
-    RooDataSet* auxData = (*iter)->finalizeRun() ;
-    if (auxData) {
-      _fitParData->merge(auxData) ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Distribute the generation and fitting of nSamples samples over _nWorkers
+/// forked worker processes. Each worker processes a contiguous block of sample
+/// numbers and sends back its rows of the fit and generator parameter datasets,
+/// the requested fit results and generated samples, and the auxiliary datasets
+/// of the study modules. These are merged in the same order as a serial run
+/// would have produced them. As each worker starts from a copy of the random
+/// generator of this process, every sample is reseeded from its sample number,
+/// using the seed set with setToySeed() or else a base seed drawn from the
+/// current generator. The returned auxiliary datasets are owned by the caller.
+/// Returns kFALSE if the samples were processed serially because forking is not
+/// supported on this platform.
+
+Bool_t RooMCStudy::runParallel(Bool_t doGenerate, Bool_t DoFit, Int_t nSamples, Int_t nEvtPerSample, Bool_t keepGenData, const char* asciiFilePat,
+			       list<RooDataSet*>& auxDataList) 
+{
+#ifndef _WIN32
+  const UInt_t origToySeed = _toySeed ;
+  if (!_toySeed) {
+    _toySeed = RooRandom::randomGenerator()->Integer(TMath::Limits<UInt_t>::Max()) ;
+  }
+
+  const Int_t nWorkers = _nWorkers<nSamples ? _nWorkers : nSamples ;
+  oocoutI(_fitModel,Generation) << "RooMCStudy::run: distributing " << nSamples << " samples over " << nWorkers 
+				<< " worker processes, toy base seed is " << _toySeed << endl ;
+
+  // Work item of one worker: process block of samples and ship back the results
+  const Int_t nGenDataBefore = _genDataList.GetSize() ;
+  auto processBlock = [&](UInt_t iWorker) {
+    const Int_t first = nSamples*Long64_t(iWorker)/nWorkers ;
+    const Int_t last = nSamples*Long64_t(iWorker+1)/nWorkers ;
+
+    // Results are collected from scratch in the worker
+    _fitParData->reset() ;
+    if (_genParData) _genParData->reset() ;
+    _fitResList.Clear() ;
+
+    runSamples(doGenerate,DoFit,first,last-first,nEvtPerSample,keepGenData,asciiFilePat) ;
+
+    TObjArray* out = new TObjArray(5) ;
+    out->AddAt(_fitParData,0) ;
+    out->AddAt(_genParData,1) ;
+    out->AddAt(&_fitResList,2) ;
+    TList* genData = new TList ;
+    for (Int_t i=nGenDataBefore ; i<_genDataList.GetSize() ; i++) {
+      genData->Add(_genDataList.At(i)) ;
+    }
+    out->AddAt(genData,3) ;
+    TObjArray* auxData = new TObjArray(_modList.size()) ;
+    Int_t imod(0) ;
+    for (list<RooAbsMCStudyModule*>::iterator iter=_modList.begin() ; iter!= _modList.end() ; ++iter) {
+      auxData->AddAt((*iter)->finalizeRun(),imod++) ;
+    }
+    out->AddAt(auxData,4) ;
+    return out ;
+  } ;
+
+  ROOT::TProcessExecutor workers(nWorkers) ;
+  std::vector<TObjArray*> results = workers.Map(processBlock, ROOT::TSeqU(nWorkers)) ;
+
+  // Merge in order of descending sample numbers, as in a serial run
+  auxDataList.assign(_modList.size(),0) ;
+  for (Int_t iWorker=nWorkers-1 ; iWorker>=0 ; --iWorker) {
+    TObjArray* out = results[iWorker] ;
+    if (!out) {
+      oocoutE(_fitModel,Generation) << "RooMCStudy::run: ERROR no results received from worker " << iWorker << endl ;
+      continue ;
     }
-  }  
 
-  _canAddFitResults = kFALSE ;
+    RooDataSet* fitParData = static_cast<RooDataSet*>(out->At(0)) ;
+    if (fitParData) _fitParData->append(*fitParData) ;
+    RooDataSet* genParData = static_cast<RooDataSet*>(out->At(1)) ;
+    if (genParData && _genParData) _genParData->append(*genParData) ;
 
-  if (_genParData) {
-    const RooArgSet* genPars = _genParData->get() ;
-    TIterator* iter2 = genPars->createIterator() ;
-    RooAbsArg* arg ;
-    while((arg=(RooAbsArg*)iter2->Next())) {
-      _genParData->changeObservableName(arg->GetName(),Form("%s_gen",arg->GetName())) ;
+    TList* fitResList = static_cast<TList*>(out->At(2)) ;
+    if (fitResList) {
+      TIter fitResIter(fitResList) ;
+      while (TObject* fr = fitResIter()) _fitResList.Add(fr) ;
+      fitResList->Clear("nodelete") ;
+    }
+    TList* genData = static_cast<TList*>(out->At(3)) ;
+    if (genData) {
+      TIter genDataIter(genData) ;
+      while (TObject* d = genDataIter()) _genDataList.Add(d) ;
+      genData->Clear("nodelete") ;
     }
-    delete iter2 ;
-    
-    _fitParData->merge(_genParData) ;
-  }
 
-  if (DoFit) calcPulls() ;
+    TObjArray* auxData = static_cast<TObjArray*>(out->At(4)) ;
+    list<RooDataSet*>::iterator aiter = auxDataList.begin() ;
+    for (Int_t imod=0 ; auxData && imod<auxData->GetSize() && aiter!=auxDataList.end() ; ++imod, ++aiter) {
+      RooDataSet* aux = static_cast<RooDataSet*>(auxData->At(imod)) ;
+      if (!aux) continue ;
+      if (!*aiter) {
+	*aiter = aux ;
+	auxData->RemoveAt(imod) ;
+      } else {
+	(*aiter)->append(*aux) ;
+      }
+    }
 
-  if (_silence) {
-    RooMsgService::instance().setGlobalKillBelow(oldLevel) ;
+    delete fitParData ;
+    delete genParData ;
+    delete fitResList ;
+    delete genData ;
+    if (auxData) auxData->SetOwner(kTRUE) ;
+    delete auxData ;
+    delete out ;
   }
 
+  _toySeed = origToySeed ;
+  return kTRUE ;
+#else
+  oocoutW(_fitModel,Generation) << "RooMCStudy::run: parallel processing is not supported on this platform, running serially" << endl ;
+  runSamples(doGenerate,DoFit,0,nSamples,nEvtPerSample,keepGenData,asciiFilePat) ;
+  for (list<RooAbsMCStudyModule*>::iterator iter=_modList.begin() ; iter!= _modList.end() ; ++iter) {
+    auxDataList.push_back((*iter)->finalizeRun()) ;
+  }
   return kFALSE ;
+#endif
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Distribute the samples of subsequent runs over nWorkers forked processes.
+/// Since the workers are independent processes the models do not need to be
+/// thread safe. Study modules are supported as long as all their output is
+/// returned through RooAbsMCStudyModule::finalizeRun(). A value of 1 (default)
+/// restores serial running.
+
+void RooMCStudy::setParallel(Int_t nWorkers)
+{
+  _nWorkers = nWorkers>1 ? nWorkers : 1 ;
 }
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Make toy studies reproducible: if seed is not zero, the random generator is
+/// reseeded before each sample with a seed derived from this seed and the sample
+/// number (see RooRandom::derivedSeed()). The outcome of each sample is then
+/// independent of the samples that precede it and of the number of parallel
+/// workers used.
+
+void RooMCStudy::setToySeed(UInt_t seed)
+{
+  _toySeed = seed ;
+}
 
 
 
@@ -61,6 +61,7 @@ automatic PDF optimization.
 #include "RooRealVar.h"
 #include "RooAbsPdf.h"
 #include "RooSentinel.h"
+#include "RooTrace.h"
 #include "RooMsgService.h"
 #include "RooPlot.h"
 
@@ -118,8 +119,10 @@ RooMinimizer::RooMinimizer(RooAbsReal& function)
   _func = &function ;
   _optConst = kFALSE ;
   _verbose = kFALSE ;
+  _useGradient = kFALSE ;
   _profile = kFALSE ;
   _profileStart = kFALSE ;
+  _evalProfile = kFALSE ;
   _printLevel = 1 ;
   _minimizerType = "Minuit"; // default minimizer
 
@@ -206,6 +209,38 @@ void RooMinimizer::setMaxFunctionCalls(Int_t n)
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// If flag is true, pass the analytical gradient of the minimized function
+/// to the minimizer whenever all its components provide analytical derivatives
+/// with respect to the floating parameters (see RooAbsReal::analyticalDerivative()).
+/// Otherwise the minimizer calculates derivatives numerically, which is the default.
+
+void RooMinimizer::setUseGradient(Bool_t flag) 
+{
+  _useGradient = flag ;
+  _fcn->SetUseGradient(flag) ;
+  if (flag && !_fcn->UseGradient()) {
+    coutI(Minimization) << "RooMinimizer::setUseGradient: " << _func->GetName() 
+			<< " does not provide an analytical gradient for all floating parameters, using numerical derivatives" << endl ;
+  }
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Run the fit of the configured minimizer on our function, passing the
+/// analytical gradient if it was requested and is available
+
+bool RooMinimizer::fitFcn() const
+{
+  if (_useGradient && _fcn->UseGradient()) {
+    return _theFitter->FitFCN(*static_cast<const ROOT::Math::IMultiGradFunction*>(_fcn)) ;
+  }
+  return _theFitter->FitFCN(*static_cast<const ROOT::Math::IMultiGenFunction*>(_fcn)) ;
+}
+
+
+
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Set the level for MINUIT error analysis to the given
@@ -320,7 +355,7 @@ Int_t RooMinimizer::minimize(const char* type, const char* alg)
   RooAbsReal::setEvalErrorLoggingMode(RooAbsReal::CollectErrors) ;
   RooAbsReal::clearEvalErrorLog() ;
 
-  bool ret = _theFitter->FitFCN(*_fcn);
+  bool ret = fitFcn();
   _status = ((ret) ? _theFitter->Result().Status() : -1);
 
   RooAbsReal::setEvalErrorLoggingMode(RooAbsReal::PrintErrors) ;
@@ -349,7 +384,7 @@ Int_t RooMinimizer::migrad()
   RooAbsReal::clearEvalErrorLog() ;
 
   _theFitter->Config().SetMinimizer(_minimizerType.c_str(),"migrad");
-  bool ret = _theFitter->FitFCN(*_fcn);
+  bool ret = fitFcn();
   _status = ((ret) ? _theFitter->Result().Status() : -1);
 
   RooAbsReal::setEvalErrorLoggingMode(RooAbsReal::PrintErrors) ;
@@ -512,7 +547,7 @@ Int_t RooMinimizer::seek()
   RooAbsReal::clearEvalErrorLog() ;
 
   _theFitter->Config().SetMinimizer(_minimizerType.c_str(),"seek");
-  bool ret = _theFitter->FitFCN(*_fcn);
+  bool ret = fitFcn();
   _status = ((ret) ? _theFitter->Result().Status() : -1);
 
   RooAbsReal::setEvalErrorLoggingMode(RooAbsReal::PrintErrors) ;
@@ -541,7 +576,7 @@ Int_t RooMinimizer::simplex()
   RooAbsReal::clearEvalErrorLog() ;
 
   _theFitter->Config().SetMinimizer(_minimizerType.c_str(),"simplex");
-  bool ret = _theFitter->FitFCN(*_fcn);
+  bool ret = fitFcn();
   _status = ((ret) ? _theFitter->Result().Status() : -1);
 
   RooAbsReal::setEvalErrorLoggingMode(RooAbsReal::PrintErrors) ;
@@ -570,7 +605,7 @@ Int_t RooMinimizer::improve()
   RooAbsReal::clearEvalErrorLog() ;
 
   _theFitter->Config().SetMinimizer(_minimizerType.c_str(),"migradimproved");
-  bool ret = _theFitter->FitFCN(*_fcn);
+  bool ret = fitFcn();
   _status = ((ret) ? _theFitter->Result().Status() : -1);
 
   RooAbsReal::setEvalErrorLoggingMode(RooAbsReal::PrintErrors) ;
@@ -796,6 +831,9 @@ RooPlot* RooMinimizer::contour(RooRealVar& var1, RooRealVar& var2,
 
 void RooMinimizer::profileStart()
 {
+  if (_evalProfile) {
+    RooTrace::profileEval(kTRUE) ;
+  }
   if (_profile) {
     _timer.Start() ;
     _cumulTimer.Start(_profileStart?kFALSE:kTRUE) ;
@@ -809,6 +847,9 @@ void RooMinimizer::profileStart()
 
 void RooMinimizer::profileStop()
 {
+  if (_evalProfile) {
+    RooTrace::profileEval(kFALSE) ;
+  }
   if (_profile) {
     _timer.Stop() ;
     _cumulTimer.Stop() ;
@@ -818,6 +859,31 @@ void RooMinimizer::profileStop()
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Enable or disable per-node profiling of the likelihood evaluation during
+/// subsequent minimization commands. Enabling clears any previously collected
+/// profile. Note that in multi-process mode (NumCPU) the nodes evaluated in
+/// the server processes are not profiled.
+
+void RooMinimizer::setEvalProfile(Bool_t flag)
+{
+  _evalProfile = flag ;
+  if (flag) {
+    RooTrace::resetEvalProfile() ;
+  }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Print per-node evaluation profile collected during the minimization
+/// commands since setEvalProfile() was called. See RooTrace::printEvalProfile()
+
+void RooMinimizer::printEvalProfile(std::ostream& os, Int_t maxNodes) const
+{
+  RooTrace::printEvalProfile(os,maxNodes) ;
+}
+
+
 
 
 
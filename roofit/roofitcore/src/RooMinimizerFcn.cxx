@@ -47,7 +47,7 @@ RooMinimizerFcn::RooMinimizerFcn(RooAbsReal *funct, RooMinimizer* context,
   _maxFCN(-1e30), _numBadNLL(0),  
   _printEvalErrors(10), _doEvalErrorWall(kTRUE),
   _nDim(0), _logfile(0),
-  _verbose(verbose)
+  _verbose(verbose), _useGradient(kFALSE)
 { 
 
   _evalCounter = 0 ;
@@ -94,7 +94,7 @@ RooMinimizerFcn::RooMinimizerFcn(RooAbsReal *funct, RooMinimizer* context,
 
 
 
-RooMinimizerFcn::RooMinimizerFcn(const RooMinimizerFcn& other) : ROOT::Math::IBaseFunctionMultiDim(other), 
+RooMinimizerFcn::RooMinimizerFcn(const RooMinimizerFcn& other) : ROOT::Math::IMultiGradFunction(other), 
   _evalCounter(other._evalCounter),
   _funct(other._funct),
   _context(other._context),
@@ -105,6 +105,7 @@ RooMinimizerFcn::RooMinimizerFcn(const RooMinimizerFcn& other) : ROOT::Math::IBa
   _nDim(other._nDim),
   _logfile(other._logfile),
   _verbose(other._verbose),
+  _useGradient(other._useGradient),
   _floatParamVec(other._floatParamVec)
 {  
   _floatParamList = new RooArgList(*other._floatParamList) ;
@@ -582,5 +583,55 @@ double RooMinimizerFcn::DoEval(const double *x) const
   return fvalue;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return true if the analytical gradient was requested and the minimized
+/// function can calculate it for all floating parameters
+
+Bool_t RooMinimizerFcn::UseGradient() const
+{
+  return _useGradient && _funct->hasAnalyticalGradient(*_floatParamList) ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Calculate the analytical gradient of the function at the given parameter values
+
+void RooMinimizerFcn::Gradient(const double *x, double *grad) const
+{
+  for (int index = 0; index < _nDim; index++) {
+    SetPdfParamVal(index,x[index]);
+  }
+
+  if (!_funct->analyticalGradient(*_floatParamList,grad)) {
+    oocoutE(_context,Minimization) << "RooMinimizerFcn::Gradient: analytical gradient of " << _funct->GetName() 
+				   << " is not available" << endl ;
+    for (int index = 0; index < _nDim; index++) grad[index] = 0 ;
+  }
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Calculate function value and analytical gradient at the given parameter values
+
+void RooMinimizerFcn::FdF(const double *x, double& f, double *df) const
+{
+  f = DoEval(x) ;
+  Gradient(x,df) ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return a single component of the analytical gradient
+
+double RooMinimizerFcn::DoDerivative(const double *x, unsigned int icoord) const
+{
+  std::vector<double> grad(_nDim) ;
+  Gradient(x,grad.data()) ;
+  return grad[icoord] ;
+}
+
 #endif
 
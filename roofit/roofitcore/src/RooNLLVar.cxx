@@ -28,6 +28,7 @@ In extended mode, a (Nexpect - Nobserved*log(NExpected) term is added
 **/
 
 #include <algorithm>
+#include <vector>
 
 #include "RooFit.h"
 #include "Riostream.h"
@@ -42,6 +43,7 @@ In extended mode, a (Nexpect - Nobserved*log(NExpected) term is added
 #include "RooRealMPFE.h"
 #include "RooRealSumPdf.h"
 #include "RooRealVar.h"
+#include "RooAbsCategory.h"
 #include "RooProdPdf.h"
 
 ClassImp(RooNLLVar);
@@ -96,6 +98,7 @@ RooNLLVar::RooNLLVar(const char *name, const char* title, RooAbsPdf& pdf, RooAbs
   _offsetCarrySaveW2 = 0.;
 
   _binnedPdf = 0 ;
+  _binnedCacheOK = kFALSE ;
 }
 
 
@@ -110,7 +113,8 @@ RooNLLVar::RooNLLVar(const char *name, const char *title, RooAbsPdf& pdf, RooAbs
   RooAbsOptTestStatistic(name,title,pdf,indata,RooArgSet(),rangeName,addCoefRangeName,nCPU,interleave,verbose,splitRange,cloneData),
   _extended(extended),
   _weightSq(kFALSE),
-  _first(kTRUE), _offsetSaveW2(0.), _offsetCarrySaveW2(0.)
+  _first(kTRUE), _offsetSaveW2(0.), _offsetCarrySaveW2(0.),
+  _binnedCacheOK(kFALSE)
 {
   // If binned likelihood flag is set, pdf is a RooRealSumPdf representing a yield vector
   // for a binned likelihood calculation
@@ -155,7 +159,8 @@ RooNLLVar::RooNLLVar(const char *name, const char *title, RooAbsPdf& pdf, RooAbs
   RooAbsOptTestStatistic(name,title,pdf,indata,projDeps,rangeName,addCoefRangeName,nCPU,interleave,verbose,splitRange,cloneData),
   _extended(extended),
   _weightSq(kFALSE),
-  _first(kTRUE), _offsetSaveW2(0.), _offsetCarrySaveW2(0.)
+  _first(kTRUE), _offsetSaveW2(0.), _offsetCarrySaveW2(0.),
+  _binnedCacheOK(kFALSE)
 {
   // If binned likelihood flag is set, pdf is a RooRealSumPdf representing a yield vector
   // for a binned likelihood calculation
@@ -196,7 +201,7 @@ RooNLLVar::RooNLLVar(const RooNLLVar& other, const char* name) :
   _weightSq(other._weightSq),
   _first(kTRUE), _offsetSaveW2(other._offsetSaveW2),
   _offsetCarrySaveW2(other._offsetCarrySaveW2),
-  _binw(other._binw) {
+  _binw(other._binw), _binnedCacheOK(kFALSE) {
   _binnedPdf = other._binnedPdf ? (RooRealSumPdf*)_funcClone : 0 ;
 }
 
@@ -230,6 +235,146 @@ void RooNLLVar::applyWeightSquared(Bool_t flag)
   } else if ( _gofOpMode==SimMaster) {
     for (Int_t i=0 ; i<_nGof ; i++)
       ((RooNLLVar*)_gofArray[i])->applyWeightSquared(flag);
+    clearSimComponentCache() ;
+    setValueDirty();
+  }
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Change dataset and invalidate the component values cached for the binned likelihood
+
+Bool_t RooNLLVar::setDataSlave(RooAbsData& indata, Bool_t cloneData, Bool_t ownNewData)
+{
+  _binnedCacheOK = kFALSE ;
+  return RooAbsOptTestStatistic::setDataSlave(indata,cloneData,ownNewData) ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Forward server redirection and invalidate the component node lists
+/// cached for the binned likelihood
+
+Bool_t RooNLLVar::redirectServersHook(const RooAbsCollection& newServerList, Bool_t mustReplaceAll, Bool_t nameChange, Bool_t isRecursive)
+{
+  _binnedCacheOK = kFALSE ;
+  return RooAbsOptTestStatistic::redirectServersHook(newServerList,mustReplaceAll,nameChange,isRecursive) ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Forward constant term optimization and invalidate the component values
+/// cached for the binned likelihood, as the constant terms cached with the
+/// dataset and the folded constant nodes may have changed
+
+void RooNLLVar::constOptimizeTestStatistic(ConstOpCode opcode, Bool_t doAlsoTrackingOpt)
+{
+  _binnedCacheOK = kFALSE ;
+  RooAbsOptTestStatistic::constOptimizeTestStatistic(opcode,doAlsoTrackingOpt) ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Update the per-bin values of the component FUNCs of the binned p.d.f. for the
+/// bins in the given partition. A component is only evaluated again if the
+/// value of one of its nodes that do not depend on the observables changed, or
+/// if one of its nodes that depend on the observables is marked shape dirty,
+/// since its bin values were last filled. The shape-dirty flags of these nodes,
+/// which can be shared by several components, are cleared once all components
+/// have been checked. A change of e.g. one nuisance
+/// parameter therefore only recalculates the samples that depend on it. The
+/// observed counts are not cached, such that changes to a dataset that is
+/// not cloned are taken into account.
+
+void RooNLLVar::updateBinnedCache(Int_t firstEvent, Int_t lastEvent, Int_t stepSize) const
+{
+  const RooArgList& funcList = _binnedPdf->funcList() ;
+  const Int_t nFunc = funcList.getSize() ;
+  const Int_t nBins = _dataClone->numEntries() ;
+
+  if (!_binnedCacheOK || _binnedCachePart[0]!=firstEvent || _binnedCachePart[1]!=lastEvent || _binnedCachePart[2]!=stepSize) {
+
+    const RooArgSet* obs = _dataClone->get() ;
+    _binnedFuncPars.assign(nFunc,RooArgList()) ;
+    _binnedFuncObsNodes.assign(nFunc,RooArgList()) ;
+    _binnedFuncParVals.assign(nFunc,std::vector<Double_t>()) ;
+    _binnedFuncVals.assign(nFunc,std::vector<Double_t>(nBins,0.)) ;
+    _binnedFuncFilled.assign(nFunc,kFALSE) ;
+    for (Int_t k=0 ; k<nFunc ; k++) {
+      RooArgSet nodes ;
+      funcList[k].treeNodeServerList(&nodes) ;
+      RooFIter iter = nodes.fwdIterator() ;
+      RooAbsArg* node ;
+      while ((node=iter.next())) {
+	if (node->dependsOn(*obs)) {
+	  if (node->isDerived() && dynamic_cast<RooAbsReal*>(node)) _binnedFuncObsNodes[k].add(*node) ;
+	} else if (!dynamic_cast<RooAbsPdf*>(node)) {
+	  // The values of p.d.f.s depend on their normalization set, their servers are tracked instead
+	  _binnedFuncPars[k].add(*node) ;
+	}
+      }
+    }
+
+    _binnedCachePart[0] = firstEvent ;
+    _binnedCachePart[1] = lastEvent ;
+    _binnedCachePart[2] = stepSize ;
+    _binnedCacheOK = kTRUE ;
+  }
+
+  // Find components with changed nodes; the first call fills all of them.
+  // Shape-dirty nodes may be shared between components, so their flags are
+  // only cleared after all components have been checked
+  std::vector<Int_t> stale ;
+  std::vector<Double_t> cur ;
+  RooArgSet shapeDirty ;
+  for (Int_t k=0 ; k<nFunc ; k++) {
+    cur.clear() ;
+    RooFIter iter = _binnedFuncPars[k].fwdIterator() ;
+    RooAbsArg* arg ;
+    while ((arg=iter.next())) {
+      RooAbsReal* real = dynamic_cast<RooAbsReal*>(arg) ;
+      if (real) {
+	cur.push_back(real->getVal()) ;
+      } else {
+	RooAbsCategory* cat = dynamic_cast<RooAbsCategory*>(arg) ;
+	if (cat) cur.push_back(cat->getIndex()) ;
+      }
+    }
+    Bool_t shapeChanged(kFALSE) ;
+    RooFIter oiter = _binnedFuncObsNodes[k].fwdIterator() ;
+    while ((arg=oiter.next())) {
+      if (arg->isShapeDirty()) {
+	shapeChanged = kTRUE ;
+	shapeDirty.add(*arg,kTRUE) ;
+      }
+    }
+    if (shapeChanged || cur!=_binnedFuncParVals[k] || !_binnedFuncFilled[k]) {
+      _binnedFuncParVals[k].swap(cur) ;
+      _binnedFuncFilled[k] = kTRUE ;
+      stale.push_back(k) ;
+    }
+  }
+
+  // P.d.f.s such as resolution models use their own shape-dirty state when
+  // they are evaluated, it is left for them to clear
+  RooFIter diter = shapeDirty.fwdIterator() ;
+  RooAbsArg* dirty ;
+  while ((dirty=diter.next())) {
+    if (!dynamic_cast<RooAbsPdf*>(dirty)) dirty->clearShapeDirty() ;
+  }
+
+  if (stale.empty()) return ;
+
+  for (Int_t i=firstEvent ; i<lastEvent ; i+=stepSize) {
+    _dataClone->get(i) ;
+    if (!_dataClone->valid()) continue ;
+    for (std::size_t j=0 ; j<stale.size() ; j++) {
+      _binnedFuncVals[stale[j]][i] = static_cast<RooAbsReal&>(funcList[stale[j]]).getVal() ;
+    }
   }
 }
 
@@ -261,18 +406,77 @@ Double_t RooNLLVar::evaluatePartition(Int_t firstEvent, Int_t lastEvent, Int_t s
   // If pdf is marked as binned - do a binned likelihood calculation here (sum of log-Poisson for each bin)
   if (_binnedPdf) {
 
+    // Unless components are deselected for plotting, bring the cached component
+    // values up to date and collect the coefficients. The sum below then
+    // reproduces RooRealSumPdf::evaluate() term by term
+    const RooArgList& funcList = _binnedPdf->funcList() ;
+    Bool_t useCache(kTRUE) ;
+    RooFIter fiter = funcList.fwdIterator() ;
+    RooAbsArg* func ;
+    while ((func=fiter.next())) {
+      if (!static_cast<RooAbsReal*>(func)->isSelectedComp()) useCache = kFALSE ;
+    }
+    std::vector<const Double_t*> termVals ;
+    std::vector<Double_t> termCoefs ;
+    Bool_t warnLastCoef(kFALSE) ;
+    Double_t lastCoef(1) ;
+    if (useCache) {
+      updateBinnedCache(firstEvent,lastEvent,stepSize) ;
+
+      const RooArgList& coefList = _binnedPdf->coefList() ;
+      const Int_t nFunc = funcList.getSize() ;
+      const Int_t nCoef = coefList.getSize() ;
+      for (Int_t k=0 ; k<nCoef ; k++) {
+	Double_t coefVal = static_cast<RooAbsReal&>(coefList[k]).getVal() ;
+	if (coefVal) {
+	  termVals.push_back(_binnedFuncVals[k].data()) ;
+	  termCoefs.push_back(coefVal) ;
+	  lastCoef -= coefVal ;
+	}
+      }
+      if (nCoef<nFunc) {
+	termVals.push_back(_binnedFuncVals[nFunc-1].data()) ;
+	termCoefs.push_back(lastCoef) ;
+	warnLastCoef = (lastCoef<0 || lastCoef>1) ;
+      }
+    }
+    const Bool_t doFloor = _binnedPdf->getFloor() || RooRealSumPdf::getFloorGlobal() ;
+    const std::size_t nTerm = termVals.size() ;
+
     for (i=firstEvent ; i<lastEvent ; i+=stepSize) {
 
       _dataClone->get(i) ;
-
       if (!_dataClone->valid()) continue;
-
       Double_t eventWeight = _dataClone->weight();
 
+      Double_t value(0) ;
+      if (useCache) {
+
+	for (std::size_t k=0 ; k<nTerm ; k++) {
+	  value += termVals[k][i]*termCoefs[k] ;
+	}
+	if (warnLastCoef) {
+	  // Same warning as RooRealSumPdf::evaluate() issues for each bin
+	  oocoutW(_binnedPdf,Eval) << "RooRealSumPdf::evaluate(" << _binnedPdf->GetName()
+				   << " WARNING: sum of FUNC coefficients not in range [0-1], value="
+				   << 1-lastCoef << std::endl ;
+	}
+	if (value<0 && doFloor) {
+	  value = 0 ;
+	}
+	if (value<0 || TMath::IsNaN(value)) {
+	  // Let the p.d.f. itself handle and report the evaluation error
+	  value = _binnedPdf->getVal() ;
+	}
+
+      } else {
+
+	value = _binnedPdf->getVal() ;
+      }
 
       // Calculate log(Poisson(N|mu) for this bin
       Double_t N = eventWeight ;
-      Double_t mu = _binnedPdf->getVal()*_binw[i] ;
+      Double_t mu = value*_binw[i] ;
       //cout << "RooNLLVar::binnedL(" << GetName() << ") N=" << N << " mu = " << mu << endl ;
 
       if (mu<=0 && N>0) {
@@ -425,4 +629,71 @@ Double_t RooNLLVar::evaluatePartition(Int_t firstEvent, Int_t lastEvent, Int_t s
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// An analytical gradient is available for unbinned, non-extended likelihoods
+/// of p.d.f.s that provide analytical derivatives for all parameters.
+
+Bool_t RooNLLVar::hasAnalyticalGradientPartition(const RooArgList& params) const
+{
+  if (_binnedPdf || _extended) return kFALSE ;
+
+  RooAbsPdf* pdfClone = (RooAbsPdf*) _funcClone ;
+  RooFIter iter = params.fwdIterator() ;
+  RooAbsArg* param ;
+  while((param=iter.next())) {
+    if (!pdfClone->hasAnalyticalDerivative(*param,_normSet)) return kFALSE ;
+  }
+  return kTRUE ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Calculate the derivatives -sum(w * dp/dparam / p) over the given event
+/// range for all parameters in a single pass over the data. Kahan summation
+/// is used for each component as in evaluatePartition().
+
+void RooNLLVar::evaluateGradientPartition(const RooArgList& params, Double_t* grad, Int_t firstEvent, Int_t lastEvent, Int_t stepSize) const
+{
+  RooAbsPdf* pdfClone = (RooAbsPdf*) _funcClone ;
+
+  // Only loop over parameters the p.d.f. actually depends on
+  Int_t n = params.getSize() ;
+  std::vector<Int_t> active ;
+  for (Int_t k=0 ; k<n ; k++) {
+    grad[k] = 0 ;
+    if (pdfClone->dependsOnValue(*params.at(k))) active.push_back(k) ;
+  }
+  if (active.empty()) return ;
+
+  std::vector<Double_t> carry(n,0.) ;
+
+  _dataClone->store()->recalculateCache( _projDeps, firstEvent, lastEvent, stepSize, kTRUE) ;
+
+  for (Int_t i=firstEvent ; i<lastEvent ; i+=stepSize) {
+
+    _dataClone->get(i) ;
+
+    if (!_dataClone->valid()) continue;
+
+    Double_t eventWeight = _dataClone->weight();
+    if (0. == eventWeight * eventWeight) continue ;
+    if (_weightSq) eventWeight = _dataClone->weightSquared() ;
+
+    Double_t prob = pdfClone->getVal(_normSet) ;
+    if (prob<=0) continue ;
+
+    for (Int_t k : active) {
+      Double_t term = -eventWeight * pdfClone->analyticalDerivative(*params.at(k),_normSet) / prob ;
+
+      Double_t y = term - carry[k];
+      Double_t t = grad[k] + y;
+      carry[k] = (t - grad[k]) - y;
+      grad[k] = t;
+    }
+  }
+}
+
+
+
 
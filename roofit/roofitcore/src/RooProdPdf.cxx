@@ -560,6 +560,74 @@ Double_t RooProdPdf::calculate(const RooProdPdf::CacheElem& cache, Bool_t /*verb
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return true if the derivative of getVal(nset) with respect to 'param' can
+/// be calculated analytically. This requires a product that factorizes into
+/// terms that are each normalized on their own (i.e. no rearranged
+/// numerator/denominator calculation) and that each provide an analytical
+/// derivative for their own normalization set.
+
+Bool_t RooProdPdf::hasAnalyticalDerivative(const RooAbsArg& param, const RooArgSet* nset) const
+{
+  if (!dependsOnValue(param)) return kTRUE ;
+  if (!_selfNorm) return kFALSE ;
+
+  Int_t code ;
+  CacheElem* cache = (CacheElem*) _cacheMgr.getObj(nset,0,&code) ;
+  if (!cache) {
+    RooArgList *plist(0) ;
+    RooLinkedList *nlist(0) ;
+    getPartIntList(nset,0,plist,nlist,code) ;
+    cache = (CacheElem*) _cacheMgr.getObj(nset,0,&code) ;
+  }
+  if (!cache || cache->_isRearranged) return kFALSE ;
+
+  RooFIter plIter = cache->_partList.fwdIterator() ;
+  RooFIter nlIter = cache->_normList.fwdIterator() ;
+  RooAbsReal* partInt ;
+  RooArgSet* normSet ;
+  while((partInt=(RooAbsReal*)plIter.next()) && (normSet=(RooArgSet*)nlIter.next())) {
+    if (!partInt->hasAnalyticalDerivative(param,normSet->getSize()>0?normSet:0)) return kFALSE ;
+  }
+  return kTRUE ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the analytical derivative of getVal(nset) with respect to 'param',
+/// applying the product rule to the factorized terms of the product
+
+Double_t RooProdPdf::analyticalDerivative(const RooAbsArg& param, const RooArgSet* nset) const
+{
+  if (!dependsOnValue(param)) return 0 ;
+
+  Int_t code ;
+  CacheElem* cache = (CacheElem*) _cacheMgr.getObj(nset,0,&code) ;
+  if (!cache) {
+    RooArgList *plist(0) ;
+    RooLinkedList *nlist(0) ;
+    getPartIntList(nset,0,plist,nlist,code) ;
+    cache = (CacheElem*) _cacheMgr.getObj(nset,0,&code) ;
+  }
+
+  // Running product and running derivative of the terms processed so far
+  Double_t prod(1), deriv(0) ;
+  RooFIter plIter = cache->_partList.fwdIterator() ;
+  RooFIter nlIter = cache->_normList.fwdIterator() ;
+  RooAbsReal* partInt ;
+  RooArgSet* normSet ;
+  while((partInt=(RooAbsReal*)plIter.next()) && (normSet=(RooArgSet*)nlIter.next())) {
+    const RooArgSet* termNormSet = normSet->getSize()>0 ? normSet : 0 ;
+    Double_t val = partInt->getVal(termNormSet) ;
+    deriv = deriv*val + prod*partInt->analyticalDerivative(param,termNormSet) ;
+    prod *= val ;
+  }
+  return deriv ;
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Factorize product in irreducible terms for given choice of integration/normalization
 
@@ -383,6 +383,49 @@ Double_t RooProduct::evaluate() const
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// The product has an analytical derivative if all real-valued terms have one.
+/// Category terms cannot depend on a real-valued parameter.
+
+Bool_t RooProduct::hasAnalyticalDerivative(const RooAbsArg& param, const RooArgSet* normSet) const
+{
+  RooFIter compRIter = _compRSet.fwdIterator() ;
+  RooAbsReal* rcomp ;
+  while((rcomp=(RooAbsReal*)compRIter.next())) {
+    if (!rcomp->hasAnalyticalDerivative(param,normSet)) return kFALSE ;
+  }
+  return kTRUE ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the analytical derivative of the product using the product rule
+
+Double_t RooProduct::analyticalDerivative(const RooAbsArg& param, const RooArgSet* normSet) const
+{
+  // Running product and running derivative of the terms processed so far
+  Double_t prod(1), deriv(0) ;
+
+  RooFIter compRIter = _compRSet.fwdIterator() ;
+  RooAbsReal* rcomp ;
+  while((rcomp=(RooAbsReal*)compRIter.next())) {
+    Double_t val = rcomp->getVal(normSet) ;
+    deriv = deriv*val + prod*rcomp->analyticalDerivative(param,normSet) ;
+    prod *= val ;
+  }
+  
+  RooFIter compCIter = _compCSet.fwdIterator() ;
+  RooAbsCategory* ccomp ;
+  while((ccomp=(RooAbsCategory*)compCIter.next())) {
+    deriv *= ccomp->getIndex() ;
+  }
+  
+  return deriv ;
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Forward the plot sampling hint from the p.d.f. that defines the observable obs  
 
@@ -114,6 +114,25 @@ Double_t RooRandom::gaussian(TRandom *generator)
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return a seed that is a deterministic function of a base seed and an index,
+/// e.g. the number of a toy experiment. Seeds derived from the same base seed
+/// for different indices are decorrelated by a 64-bit avalanche mixing function,
+/// so that sequences of experiments can be reproduced regardless of how they are
+/// distributed over parallel workers. The returned seed is never zero, as a zero
+/// seed makes TRandom3 pick a time-dependent seed.
+
+UInt_t RooRandom::derivedSeed(UInt_t baseSeed, ULong64_t index)
+{
+  ULong64_t z = (ULong64_t(baseSeed) << 32) + index + 0x9E3779B97F4A7C15ULL ;
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL ;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL ;
+  z = z ^ (z >> 31) ;
+  UInt_t seed = UInt_t(z ^ (z >> 32)) ;
+  return seed ? seed : 1 ;
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return a quasi-random number in the range (0,1) using the
 /// Niederreiter base 2 generator described in Bratley, Fox, Niederreiter,
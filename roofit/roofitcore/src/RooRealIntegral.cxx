@@ -58,6 +58,8 @@ ClassImp(RooRealIntegral);
 
 
 Int_t RooRealIntegral::_cacheAllNDim(2) ;
+Int_t RooRealIntegral::_numIntCacheSize(8) ;
+Double_t RooRealIntegral::_numIntCacheTol(0.) ;
 
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -75,7 +77,8 @@ RooRealIntegral::RooRealIntegral() :
   _numIntegrand(0),
   _rangeName(0),
   _params(0),
-  _cacheNum(kFALSE)
+  _cacheNum(kFALSE),
+  _numIntCacheNext(0)
 {
   _facListIter = _facList.createIterator() ;
   _jacListIter = _jacList.createIterator() ;
@@ -119,7 +122,8 @@ RooRealIntegral::RooRealIntegral(const char *name, const char *title,
   _numIntegrand(0),
   _rangeName((TNamed*)RooNameReg::ptr(rangeName)),
   _params(0),
-  _cacheNum(kFALSE)
+  _cacheNum(kFALSE),
+  _numIntCacheNext(0)
 {
   //   A) Check that all dependents are lvalues 
   //
@@ -776,7 +780,8 @@ RooRealIntegral::RooRealIntegral(const RooRealIntegral& other, const char* name)
   _numIntegrand(0),
   _rangeName(other._rangeName),
   _params(0),
-  _cacheNum(kFALSE)
+  _cacheNum(kFALSE),
+  _numIntCacheNext(0)
 {
  _funcNormSet = other._funcNormSet ? (RooArgSet*)other._funcNormSet->snapshot(kFALSE) : 0 ;
 
@@ -909,6 +914,8 @@ Double_t RooRealIntegral::evaluate() const
       if (cacheVal) {
         retVal = *cacheVal ;
 	//	cout << "using cached value of integral" << GetName() << endl ;
+      } else if (numIntCacheLookup(retVal)) {
+        // Value for these parameters was calculated before by this integral
       } else {
 
 
@@ -946,6 +953,7 @@ Double_t RooRealIntegral::evaluate() const
           expensiveObjectCache().registerObject(_function.arg().GetName(),GetName(),*val,parameters())  ;
           //  	  cout << "### caching value of integral" << GetName() << " in " << &expensiveObjectCache() << endl ;
         }
+        numIntCacheStore(retVal) ;
         
       }
       break ;
@@ -1097,6 +1105,11 @@ Bool_t RooRealIntegral::redirectServersHook(const RooAbsCollection& /*newServerL
     _params = 0 ;
   }
 
+  // Cached numeric integral values refer to the old servers
+  _numIntCacheKeys.clear() ;
+  _numIntCacheVals.clear() ;
+  _numIntCacheNext = 0 ;
+
   return kFALSE ;
 }
 
@@ -1244,3 +1257,160 @@ Int_t RooRealIntegral::getCacheAllNumeric()
 }
 
 
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Set the number of parameter points for which each numeric integral keeps
+/// its value. The cache applies to the integrals that are also stored in the
+/// expensive object cache, i.e. those with setCacheNumeric(kTRUE) or with at
+/// least getCacheAllNumeric() numerically integrated dimensions. Zero disables it.
+
+void RooRealIntegral::setNumIntCacheSize(Int_t nEntries)
+{
+  if (nEntries<0) {
+    oocoutE((TObject*)0,InputArguments) << "RooRealIntegral::setNumIntCacheSize() ERROR: number of entries must not be negative" << endl ;
+    return ;
+  }
+  _numIntCacheSize = nEntries ;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the number of parameter points for which numeric integral values are kept
+
+Int_t RooRealIntegral::getNumIntCacheSize()
+{
+  return _numIntCacheSize ;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Set the relative tolerance within which a cached numeric integral value is
+/// reused for different parameter values. The default of zero requires an exact
+/// match. A non-zero tolerance must stay well below the step sizes of the
+/// minimizer, otherwise numerical derivatives of the likelihood become zero.
+
+void RooRealIntegral::setNumIntCacheTolerance(Double_t relTol)
+{
+  if (relTol<0) {
+    oocoutE((TObject*)0,InputArguments) << "RooRealIntegral::setNumIntCacheTolerance() ERROR: tolerance must not be negative" << endl ;
+    return ;
+  }
+  _numIntCacheTol = relTol ;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the relative tolerance within which cached numeric integral values are reused
+
+Double_t RooRealIntegral::getNumIntCacheTolerance()
+{
+  return _numIntCacheTol ;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return kTRUE if this integral is eligible for the numeric integral value cache
+/// in its current state
+
+Bool_t RooRealIntegral::numIntCacheActive() const
+{
+  if (_numIntCacheSize==0 || !RooAbsReal::_globalSelectComp) return kFALSE ;
+  return (_cacheNum && _intList.getSize()>0) || _intList.getSize()>=_cacheAllNDim ;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Fill key with the current values of the parameters of the integral and the
+/// integration limits of the numerically integrated observables
+
+void RooRealIntegral::numIntCacheKey(std::vector<Double_t>& key) const
+{
+  key.clear() ;
+
+  RooFIter piter = parameters().fwdIterator() ;
+  RooAbsArg* arg ;
+  while ((arg=piter.next())) {
+    RooAbsReal* real = dynamic_cast<RooAbsReal*>(arg) ;
+    if (real) {
+      key.push_back(real->getVal()) ;
+    } else {
+      RooAbsCategory* cat = dynamic_cast<RooAbsCategory*>(arg) ;
+      if (cat) key.push_back(cat->getIndex()) ;
+    }
+  }
+
+  RooFIter iiter = _intList.fwdIterator() ;
+  while ((arg=iiter.next())) {
+    RooAbsRealLValue* lval = dynamic_cast<RooAbsRealLValue*>(arg) ;
+    if (lval) {
+      key.push_back(lval->getMin(RooNameReg::str(_rangeName))) ;
+      key.push_back(lval->getMax(RooNameReg::str(_rangeName))) ;
+    }
+  }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Look up the integral value for the current parameters in the numeric
+/// integral value cache. Of all matching entries the most recent one is used.
+/// Return kTRUE and set value if an entry was found.
+
+Bool_t RooRealIntegral::numIntCacheLookup(Double_t& value) const
+{
+  if (!numIntCacheActive() || _numIntCacheVals.empty()) return kFALSE ;
+
+  numIntCacheKey(_numIntCacheCurKey) ;
+
+  const Int_t nval = _numIntCacheVals.size() ;
+  for (Int_t i=1 ; i<=nval ; i++) {
+    const Int_t idx = (_numIntCacheNext-i+nval) % nval ;
+    const std::vector<Double_t>& key = _numIntCacheKeys[idx] ;
+    if (key.size()!=_numIntCacheCurKey.size()) continue ;
+
+    Bool_t match(kTRUE) ;
+    for (std::size_t k=0 ; k<key.size() ; k++) {
+      if (fabs(key[k]-_numIntCacheCurKey[k]) > _numIntCacheTol*fabs(key[k])) {
+	match = kFALSE ;
+	break ;
+      }
+    }
+    if (match) {
+      value = _numIntCacheVals[idx] ;
+      return kTRUE ;
+    }
+  }
+
+  return kFALSE ;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Store integral value calculated for the current parameters in the numeric
+/// integral value cache, replacing the oldest entry if the cache is full
+
+void RooRealIntegral::numIntCacheStore(Double_t value) const
+{
+  if (!numIntCacheActive()) return ;
+
+  numIntCacheKey(_numIntCacheCurKey) ;
+
+  if ((Int_t)_numIntCacheVals.size()<_numIntCacheSize) {
+    _numIntCacheKeys.push_back(_numIntCacheCurKey) ;
+    _numIntCacheVals.push_back(value) ;
+    _numIntCacheNext = _numIntCacheVals.size() % _numIntCacheSize ;
+    return ;
+  }
+
+  // Cache size may have been reduced since the entries were stored
+  if ((Int_t)_numIntCacheVals.size()>_numIntCacheSize) {
+    _numIntCacheKeys.resize(_numIntCacheSize) ;
+    _numIntCacheVals.resize(_numIntCacheSize) ;
+    _numIntCacheNext = 0 ;
+  }
+
+  _numIntCacheKeys[_numIntCacheNext] = _numIntCacheCurKey ;
+  _numIntCacheVals[_numIntCacheNext] = value ;
+  _numIntCacheNext = (_numIntCacheNext+1) % _numIntCacheSize ;
+}
@@ -24,6 +24,15 @@ objects. When tracing is active, a table of live RooFit objects
 is kept that can be queried at any time. In verbose mode, messages
 are printed in addition at the construction and destruction of
 each object.
+
+RooTrace also contains a per-node profiler for the evaluation of
+RooFit expression trees, activated with RooTrace::profileEval(). While
+active, it records for each RooAbsArg the number of getVal() calls, the
+number of calls that required an evaluation, the hits and misses in the
+normalization and object caches owned by the node, and the time spent
+in evaluation, both inclusive and exclusive of the evaluation of its
+servers. The profile is printed with RooTrace::printEvalProfile(), or
+after a fit with RooMinimizer::printEvalProfile().
 **/
 
 #include "RooFit.h"
@@ -34,6 +43,7 @@ each object.
 #include "RooMsgService.h"
 
 #include <iomanip>
+#include <algorithm>
 
 
 
@@ -43,6 +53,8 @@ ClassImp(RooTrace);
 ;
 
 RooTrace* RooTrace::_instance=0 ;
+Bool_t RooTrace::_profileEval=kFALSE ;
+Bool_t RooTrace::_profileEvalFilled=kFALSE ;
 
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -311,3 +323,161 @@ void RooTrace::callgrind_dump()
 {
   ooccoutD((TObject*)0,Tracing) << "RooTrace::callgrind_dump()" << endl ;
 }
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// If flag is true, the per-node evaluation profiler is activated. Profile
+/// data accumulates until resetEvalProfile() is called.
+
+void RooTrace::profileEval(Bool_t flag)
+{
+  _profileEval = flag ;
+  if (!flag) {
+    RooTrace::instance()._evalStack.clear() ;
+  }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Clear all collected evaluation profile data
+
+void RooTrace::resetEvalProfile()
+{
+  RooTrace& instance = RooTrace::instance() ;
+  instance._evalProfile.clear() ;
+  instance._evalProfileDeleted.clear() ;
+  instance._evalStack.clear() ;
+  _profileEvalFilled = kFALSE ;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return profile entry for given node. Entries are keyed by the address of
+/// the node; when a node is deleted, its entry is moved out of the map by
+/// evalProfileRemove(), such that a new node at the same address starts with
+/// an empty entry.
+
+RooTrace::EvalProfileEntry& RooTrace::profileEntry(const RooAbsArg* arg)
+{
+  auto iter = _evalProfile.find(arg) ;
+  if (iter!=_evalProfile.end()) {
+    return iter->second ;
+  }
+
+  EvalProfileEntry& entry = _evalProfile[arg] ;
+  entry._name = arg->GetName() ;
+  entry._className = arg->IsA()->GetName() ;
+  _profileEvalFilled = kTRUE ;
+  return entry ;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Called by the destructor of a node when profile data was collected. The
+/// profile entry of the node, if any, is kept for printEvalProfile() but no
+/// longer associated with its address.
+
+void RooTrace::evalProfileRemove(const RooAbsArg* arg)
+{
+  RooTrace& instance = RooTrace::instance() ;
+  auto iter = instance._evalProfile.find(arg) ;
+  if (iter==instance._evalProfile.end()) return ;
+
+  instance._evalProfileDeleted.push_back(iter->second) ;
+  instance._evalProfile.erase(iter) ;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Register start of evaluation of given node. Must be followed by a
+/// matching evalStop()
+
+void RooTrace::evalStart(const RooAbsArg* arg)
+{
+  RooTrace& instance = RooTrace::instance() ;
+  EvalProfileEntry& entry = instance.profileEntry(arg) ;
+  entry._nCalls++ ;
+  entry._nEvals++ ;
+  instance._evalStack.push_back({&entry, std::chrono::steady_clock::now(), 0.}) ;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Register end of evaluation of the node passed to the last evalStart()
+
+void RooTrace::evalStop()
+{
+  RooTrace& instance = RooTrace::instance() ;
+  if (instance._evalStack.empty()) return ;
+
+  const EvalFrame& frame = instance._evalStack.back() ;
+  const Double_t elapsed = std::chrono::duration<Double_t>(std::chrono::steady_clock::now() - frame._start).count() ;
+  frame._entry->_inclTime += elapsed ;
+  frame._entry->_exclTime += elapsed - frame._childTime ;
+  instance._evalStack.pop_back() ;
+
+  if (!instance._evalStack.empty()) {
+    instance._evalStack.back()._childTime += elapsed ;
+  }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Register getVal() call on given node that was served from the value cache
+
+void RooTrace::valueCacheHit(const RooAbsArg* arg)
+{
+  RooTrace::instance().profileEntry(arg)._nCalls++ ;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Register a lookup in a normalization or object cache owned by given node
+
+void RooTrace::cacheAccess(const RooAbsArg* owner, Bool_t hit)
+{
+  if (!owner) return ;
+  EvalProfileEntry& entry = RooTrace::instance().profileEntry(owner) ;
+  if (hit) {
+    entry._nCacheHits++ ;
+  } else {
+    entry._nCacheMiss++ ;
+  }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Print evaluation profile of the maxNodes nodes with the largest inclusive
+/// evaluation time. If maxNodes is zero or negative, all nodes are printed
+
+void RooTrace::printEvalProfile(ostream& os, Int_t maxNodes)
+{
+  RooTrace& instance = RooTrace::instance() ;
+
+  vector<const EvalProfileEntry*> entries ;
+  for (const auto& item : instance._evalProfile) {
+    entries.push_back(&item.second) ;
+  }
+  for (const auto& entry : instance._evalProfileDeleted) {
+    entries.push_back(&entry) ;
+  }
+  size_t nNodes = entries.size() ;
+  sort(entries.begin(), entries.end(), [](const EvalProfileEntry* a, const EvalProfileEntry* b) {
+    return a->_inclTime > b->_inclTime ;
+  }) ;
+  if (maxNodes>0 && entries.size()>size_t(maxNodes)) {
+    entries.resize(maxNodes) ;
+  }
+
+  os << "RooTrace::printEvalProfile: evaluation profile of " << nNodes << " nodes" << endl
+     << setw(40) << "node" << setw(12) << "calls" << setw(12) << "evals"
+     << setw(12) << "cacheHits" << setw(12) << "cacheMiss" << setw(12) << "incl[s]" << setw(12) << "excl[s]" << endl ;
+  for (auto entry : entries) {
+    string name = entry->_className + "::" + entry->_name ;
+    if (name.size()>38) name = name.substr(0,35) + "..." ;
+    os << setw(40) << name << setw(12) << entry->_nCalls << setw(12) << entry->_nEvals
+       << setw(12) << entry->_nCacheHits << setw(12) << entry->_nCacheMiss
+       << setw(12) << Form("%.4g",entry->_inclTime) << setw(12) << Form("%.4g",entry->_exclTime) << endl ;
+  }
+}
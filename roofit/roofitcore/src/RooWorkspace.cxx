@@ -32,6 +32,12 @@ ROOT distribution, portability of workspaces can be enhanced by
 storing the source code of those classes in the workspace as well.
 This process is also organized by the workspace through the
 `importClassCode()` method.
+
+For workspaces with large datasets, `setLazyDataIO()` stores each dataset as
+a separate serialized buffer when the workspace is written. When such a
+workspace is read back, a dataset is only deserialized when it is first
+accessed through `data()` (or `allData()`), which makes opening the workspace
+fast if only some of the datasets are used.
 **/
 
 #include "RooFit.h"
@@ -57,6 +63,7 @@ This process is also organized by the workspace through the
 #include "RooAbsOptTestStatistic.h"
 #include "TROOT.h"
 #include "TFile.h"
+#include "TBufferFile.h"
 #include "TH1.h"
 #include <map>
 
@@ -141,7 +148,7 @@ void RooWorkspace::autoImportClassCode(Bool_t flag)
 ////////////////////////////////////////////////////////////////////////////////
 /// Default constructor
 
-RooWorkspace::RooWorkspace() : _classes(this), _dir(nullptr), _factory(nullptr), _doExport(kFALSE), _openTrans(kFALSE)
+RooWorkspace::RooWorkspace() : _classes(this), _dir(nullptr), _factory(nullptr), _doExport(kFALSE), _openTrans(kFALSE), _lazyDataIO(kFALSE)
 {
 }
 
@@ -151,13 +158,13 @@ RooWorkspace::RooWorkspace() : _classes(this), _dir(nullptr), _factory(nullptr),
 /// Construct empty workspace with given name and title
 
 RooWorkspace::RooWorkspace(const char* name, const char* title) : 
-  TNamed(name,title?title:name), _classes(this), _dir(nullptr), _factory(nullptr), _doExport(kFALSE), _openTrans(kFALSE)
+  TNamed(name,title?title:name), _classes(this), _dir(nullptr), _factory(nullptr), _doExport(kFALSE), _openTrans(kFALSE), _lazyDataIO(kFALSE)
 {
 }
 
 
 RooWorkspace::RooWorkspace(const char* name, Bool_t doCINTExport)  : 
-  TNamed(name,name), _classes(this), _dir(nullptr), _factory(nullptr), _doExport(kFALSE), _openTrans(kFALSE)
+  TNamed(name,name), _classes(this), _dir(nullptr), _factory(nullptr), _doExport(kFALSE), _openTrans(kFALSE), _lazyDataIO(kFALSE)
 {
   // Construct empty workspace with given name and option to export reference to all workspace contents to a CINT namespace with the same name
   if (doCINTExport) {
@@ -170,12 +177,13 @@ RooWorkspace::RooWorkspace(const char* name, Bool_t doCINTExport)  :
 /// Workspace copy constructor
 
 RooWorkspace::RooWorkspace(const RooWorkspace& other) : 
-  TNamed(other), _uuid(other._uuid), _classes(other._classes,this), _dir(nullptr), _factory(nullptr), _doExport(kFALSE), _openTrans(kFALSE)
+  TNamed(other), _uuid(other._uuid), _classes(other._classes,this), _dir(nullptr), _factory(nullptr), _doExport(kFALSE), _openTrans(kFALSE), _lazyDataIO(other._lazyDataIO)
 {
   // Copy owned nodes
   other._allOwnedNodes.snapshot(_allOwnedNodes,kTRUE) ;
 
   // Copy datasets
+  other.loadAllData() ;
   TIterator* iter = other._dataList.MakeIterator() ;
   TObject* data2 ;
   while((data2=iter->Next())) {
@@ -225,6 +233,7 @@ RooWorkspace::~RooWorkspace()
 
   // Delete contents
   _dataList.Delete() ;
+  _dataBuffers.Delete() ;
   if (_dir) {
     delete _dir ;
   }
@@ -801,6 +810,7 @@ Bool_t RooWorkspace::import(RooAbsData& inData,
   RooLinkedList& dataList = embedded ? _embeddedDataList : _dataList ;
 
   // Check that no dataset with target name already exists
+  if (!embedded) loadAllData() ;
   if (dsetName && dataList.FindObject(dsetName)) {
     coutE(ObjectHandling) << "RooWorkspace::import(" << GetName() << ") ERROR dataset with name " << dsetName << " already exists in workspace, import aborted" << endl ;
     return kTRUE ;
@@ -1414,7 +1424,67 @@ RooAbsArg* RooWorkspace::fundArg(const char* name) const
 
 RooAbsData* RooWorkspace::data(const char* name) const
 {
-  return (RooAbsData*)_dataList.FindObject(name) ;
+  RooAbsData* ret = (RooAbsData*)_dataList.FindObject(name) ;
+  if (!ret && _dataBuffers.GetSize()>0) {
+    ret = loadData(name) ;
+  }
+  return ret ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Deserialize dataset with given name that was stored as a separate buffer
+/// (see setLazyDataIO()) and move it to the list of datasets. A null pointer
+/// is returned if no such buffer exists.
+
+RooAbsData* RooWorkspace::loadData(const char* name) const
+{
+  DataBuffer* dbuf = (DataBuffer*) _dataBuffers.FindObject(name) ;
+  if (!dbuf) return 0 ;
+
+  const std::vector<char>& bytes = dbuf->buffer() ;
+  TBufferFile buf(TBuffer::kRead,bytes.size(),const_cast<char*>(bytes.data()),kFALSE) ;
+  RooAbsData* ret = (RooAbsData*) buf.ReadObject(RooAbsData::Class()) ;
+  if (!ret) {
+    coutE(ObjectHandling) << "RooWorkspace::data(" << GetName() << ") ERROR reading dataset " << name << endl ;
+    return 0 ;
+  }
+
+  // Perform any pass-2 schema evolution of the dataset variables
+  RooFIter viter = ret->get()->fwdIterator() ;
+  RooAbsArg* var ;
+  while((var=viter.next())) {
+    var->ioStreamerPass2() ;
+  }
+  RooAbsArg::ioStreamerPass2Finalize() ;
+
+  coutI(ObjectHandling) << "RooWorkspace::data(" << GetName() << ") loaded dataset " << name << endl ;
+  _dataBuffers.Remove(dbuf) ;
+  delete dbuf ;
+  const_cast<RooLinkedList&>(_dataList).Add(ret) ;
+  if (_doExport) {
+    const_cast<RooWorkspace*>(this)->exportObj(ret) ;
+  }
+  return ret ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Deserialize all datasets that are stored as separate buffers
+
+void RooWorkspace::loadAllData() const
+{
+  while (_dataBuffers.GetSize()>0) {
+    const char* name = _dataBuffers.At(0)->GetName() ;
+    if (!loadData(name)) {
+      // Drop unreadable buffer, error was reported by loadData()
+      TObject* dbuf = _dataBuffers.At(0) ;
+      _dataBuffers.Remove(dbuf) ;
+      delete dbuf ;
+    }
+  }
 }
 
 
@@ -1563,6 +1633,7 @@ RooArgSet RooWorkspace::allPdfs() const
 
 list<RooAbsData*> RooWorkspace::allData() const 
 {
+  loadAllData() ;
   list<RooAbsData*> ret ;
   TIterator* iter = _dataList.MakeIterator() ;
   RooAbsData* dat ;
@@ -2412,7 +2483,7 @@ void RooWorkspace::Print(Option_t* opts) const
     cout << endl ;
   }
 
-  if (_dataList.GetSize()>0) {
+  if (_dataList.GetSize()>0 || _dataBuffers.GetSize()>0) {
     cout << "datasets" << endl ;
     cout << "--------" << endl ;
     iter = _dataList.MakeIterator() ;
@@ -2421,6 +2492,11 @@ void RooWorkspace::Print(Option_t* opts) const
       cout << data2->IsA()->GetName() << "::" << data2->GetName() << *data2->get() << endl ;
     }
     delete iter ;
+    RooFIter biter = _dataBuffers.fwdIterator() ;
+    TObject* dbuf ;
+    while((dbuf=biter.next())) {
+      cout << dbuf->GetName() << " (not yet loaded)" << endl ;
+    }
     cout << endl ;
   }
 
@@ -2640,34 +2716,30 @@ void RooWorkspace::Streamer(TBuffer &R__b)
    if (R__b.IsReading()) {
 
       R__b.ReadClassBuffer(RooWorkspace::Class(),this);
-            
-      // Perform any pass-2 schema evolution here
+
+      // Perform any pass-2 schema evolution here. Make expensive object cache
+      // of all objects point to internal copy. Somehow this doesn't work OK
+      // automatically
       RooFIter fiter = _allOwnedNodes.fwdIterator() ;
       RooAbsArg* node ;
       while((node=fiter.next())) {
-	node->ioStreamerPass2() ;
+        node->ioStreamerPass2() ;
+        node->setExpensiveObjectCache(_eocache) ;
+        node->setWorkspace(*this);
+        RooAbsOptTestStatistic *tmp = dynamic_cast<RooAbsOptTestStatistic*>(node) ;
+        if (tmp && tmp->isSealed() && tmp->sealNotice() && strlen(tmp->sealNotice()) > 0) {
+          cout << "RooWorkspace::Streamer(" << GetName() << ") " << node->IsA()->GetName() << "::" << node->GetName()
+               << " : " << tmp->sealNotice() << endl;
+        }
       }
       RooAbsArg::ioStreamerPass2Finalize() ;
-      
-      // Make expensive object cache of all objects point to intermal copy.
-      // Somehow this doesn't work OK automatically
-      TIterator* iter = _allOwnedNodes.createIterator() ;
-      while((node=(RooAbsArg*)iter->Next())) {
-	node->setExpensiveObjectCache(_eocache) ;
-   node->setWorkspace(*this);
-   if (node->IsA()->InheritsFrom(RooAbsOptTestStatistic::Class())) {
-      RooAbsOptTestStatistic *tmp = (RooAbsOptTestStatistic *)node;
-      if (tmp->isSealed() && tmp->sealNotice() && strlen(tmp->sealNotice()) > 0) {
-         cout << "RooWorkspace::Streamer(" << GetName() << ") " << node->IsA()->GetName() << "::" << node->GetName()
-              << " : " << tmp->sealNotice() << endl;
-      }
-   }
-      }
-      delete iter ;
-
 
    } else {
 
+     // Datasets that were read lazily are deserialized first, such that they
+     // are written with the class versions and StreamerInfos of this process
+     loadAllData() ;
+
      // Make lists of external clients of WS objects, and remove those links temporarily
 
      map<RooAbsArg*,list<RooAbsArg*> > extClients, extValueClients, extShapeClients ;
@@ -2722,8 +2794,33 @@ void RooWorkspace::Streamer(TBuffer &R__b)
      }
      delete iter ;
 
+     // Serialize datasets into separate buffers if requested. The file being
+     // written is set as parent of each buffer, so that the StreamerInfos of
+     // the dataset classes are stored in the file
+     std::vector<TObject*> lazyData ;
+     if (_lazyDataIO) {
+       RooFIter diter = _dataList.fwdIterator() ;
+       TObject* data2 ;
+       while((data2=diter.next())) {
+         TBufferFile buf(TBuffer::kWrite) ;
+         buf.SetParent(dynamic_cast<TFile*>(R__b.GetParent())) ;
+         buf.WriteObject(data2) ;
+         _dataBuffers.Add(new DataBuffer(data2->GetName(),buf.Buffer(),buf.Length())) ;
+         lazyData.push_back(data2) ;
+       }
+       _dataList.Clear() ;
+     }
+
      R__b.WriteClassBuffer(RooWorkspace::Class(),this);
 
+     // Restore datasets and remove their temporary buffers
+     for (auto data2 : lazyData) {
+       _dataList.Add(data2) ;
+       TObject* dbuf = _dataBuffers.At(_dataBuffers.GetSize()-1) ;
+       _dataBuffers.Remove(dbuf) ;
+       delete dbuf ;
+     }
+
      // Reinstate clients here
 
      
@@ -0,0 +1,56 @@
+#include <RooRealVar.h>
+#include <RooGaussian.h>
+#include <RooAddPdf.h>
+#include <RooDataSet.h>
+#include <RooArgList.h>
+#include <RooAbsReal.h>
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+
+// Compare the analytical gradient of an unbinned likelihood with central finite differences
+TEST(RooNLLVar, AnalyticalGradient)
+{
+   RooRealVar x("x", "x", -10, 10);
+   RooRealVar mean1("mean1", "mean1", 1, -5, 5);
+   RooRealVar sigma1("sigma1", "sigma1", 1.5, 0.1, 10);
+   RooRealVar mean2("mean2", "mean2", -2, -5, 5);
+   RooRealVar sigma2("sigma2", "sigma2", 3, 0.1, 10);
+   RooRealVar frac("frac", "frac", 0.3, 0, 1);
+   RooGaussian g1("g1", "g1", x, mean1, sigma1);
+   RooGaussian g2("g2", "g2", x, mean2, sigma2);
+   RooAddPdf model("model", "model", RooArgList(g1, g2), RooArgList(frac));
+
+   std::unique_ptr<RooDataSet> data(model.generate(x, 500));
+
+   // Move away from the generating values so that the gradient is not zero
+   mean1.setVal(0.8);
+   sigma1.setVal(1.7);
+   frac.setVal(0.4);
+
+   std::unique_ptr<RooAbsReal> nll(model.createNLL(*data));
+   RooArgList params(mean1, sigma1, mean2, sigma2, frac);
+
+   ASSERT_TRUE(nll->hasAnalyticalGradient(params));
+
+   std::vector<Double_t> grad(params.getSize());
+   ASSERT_TRUE(nll->analyticalGradient(params, grad.data()));
+
+   const Double_t eps = 1e-5;
+   for (Int_t i = 0; i < params.getSize(); ++i) {
+      RooRealVar &par = static_cast<RooRealVar &>(params[i]);
+      const Double_t val = par.getVal();
+      par.setVal(val + eps);
+      const Double_t up = nll->getVal();
+      par.setVal(val - eps);
+      const Double_t down = nll->getVal();
+      par.setVal(val);
+
+      EXPECT_NEAR(grad[i], (up - down) / (2 * eps), 1e-4 * std::max(1., std::abs(grad[i]))) << par.GetName();
+   }
+}
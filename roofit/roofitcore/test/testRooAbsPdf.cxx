@@ -0,0 +1,75 @@
+#include <RooRealVar.h>
+#include <RooPolynomial.h>
+#include <RooExtendPdf.h>
+#include <RooDataSet.h>
+#include <RooArgSet.h>
+#include <RooArgList.h>
+#include <RooGlobalFunc.h>
+#include <RooRandom.h>
+#include <RooMsgService.h>
+
+#include <memory>
+
+#include "gtest/gtest.h"
+
+
+// Generation in several processes yields the requested number of events and is reproducible
+TEST(RooAbsPdf, GenerateParallel)
+{
+   RooMsgService::instance().setGlobalKillBelow(RooFit::WARNING);
+
+   // A polynomial is sampled with accept/reject, which needs an initialized generator
+   RooRealVar x("x", "x", 0, 10);
+   RooRealVar a1("a1", "a1", 0.3);
+   RooRealVar a2("a2", "a2", -0.02);
+   RooPolynomial poly("poly", "poly", x, RooArgList(a1, a2));
+
+   RooRandom::randomGenerator()->SetSeed(5);
+   std::unique_ptr<RooDataSet> first(poly.generate(x, 1000, RooFit::NumCPU(3)));
+   RooRandom::randomGenerator()->SetSeed(5);
+   std::unique_ptr<RooDataSet> second(poly.generate(x, 1000, RooFit::NumCPU(3)));
+
+   ASSERT_TRUE(first && second);
+   ASSERT_EQ(first->numEntries(), 1000);
+   ASSERT_EQ(second->numEntries(), 1000);
+   for (Int_t i = 0; i < first->numEntries(); ++i) {
+      const Double_t val = first->get(i)->getRealValue("x");
+      EXPECT_GE(val, 0.);
+      EXPECT_LE(val, 10.);
+      EXPECT_EQ(val, second->get(i)->getRealValue("x")) << "event " << i;
+   }
+
+   // Extended generation draws the total number of events once
+   RooRealVar nExp("nExp", "nExp", 500);
+   RooExtendPdf extPoly("extPoly", "extPoly", poly, nExp);
+   RooRandom::randomGenerator()->SetSeed(7);
+   std::unique_ptr<RooDataSet> extFirst(extPoly.generate(x, RooFit::Extended(), RooFit::NumCPU(3)));
+   RooRandom::randomGenerator()->SetSeed(7);
+   std::unique_ptr<RooDataSet> extSecond(extPoly.generate(x, RooFit::Extended(), RooFit::NumCPU(3)));
+
+   ASSERT_TRUE(extFirst && extSecond);
+   EXPECT_GT(extFirst->numEntries(), 400);
+   EXPECT_LT(extFirst->numEntries(), 600);
+   ASSERT_EQ(extFirst->numEntries(), extSecond->numEntries());
+   for (Int_t i = 0; i < extFirst->numEntries(); ++i) {
+      EXPECT_EQ(extFirst->get(i)->getRealValue("x"), extSecond->get(i)->getRealValue("x")) << "event " << i;
+   }
+}
+
+// Without a number of events, a p.d.f. that cannot be extended gives the same result as the serial generation
+TEST(RooAbsPdf, GenerateParallelNoEvents)
+{
+   RooMsgService::instance().setGlobalKillBelow(RooFit::WARNING);
+
+   RooRealVar x("x", "x", 0, 10);
+   RooRealVar a1("a1", "a1", 0.3);
+   RooPolynomial poly("poly", "poly", x, RooArgList(a1));
+
+   std::unique_ptr<RooDataSet> serial(poly.generate(x));
+   std::unique_ptr<RooDataSet> parallel(poly.generate(x, RooFit::NumCPU(3)));
+
+   ASSERT_EQ(serial == nullptr, parallel == nullptr);
+   if (serial) {
+      EXPECT_EQ(parallel->numEntries(), serial->numEntries());
+   }
+}
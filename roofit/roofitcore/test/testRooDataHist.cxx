@@ -0,0 +1,44 @@
+#include <RooRealVar.h>
+#include <RooBinning.h>
+#include <RooDataHist.h>
+#include <RooArgSet.h>
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+
+// Compare the batch weight lookup with weight() for each point, including points outside of the range
+TEST(RooDataHist, BatchWeights)
+{
+   RooRealVar x("x", "x", 0, 10);
+   RooRealVar y("y", "y", 0, 10);
+   x.setBins(10);
+   RooBinning ybins(0, 10);
+   ybins.addBoundary(1);
+   ybins.addBoundary(3);
+   ybins.addBoundary(6);
+   y.setBinning(ybins);
+
+   RooDataHist hist("hist", "hist", RooArgSet(x, y));
+   for (Int_t i = 0; i < hist.numEntries(); ++i) {
+      hist.get(i);
+      hist.set(1. + i);
+   }
+
+   std::vector<Double_t> xs{-1., 0., 0.5, 3.3, 9.99, 10., 12.};
+   std::vector<Double_t> ys{-5., 0.2, 2., 4.5, 7., 10., 15.};
+   const Int_t n = xs.size();
+   const Double_t *coords[2] = {xs.data(), ys.data()};
+
+   for (Bool_t correctForBinSize : {kFALSE, kTRUE}) {
+      std::vector<Double_t> batch(n);
+      ASSERT_TRUE(hist.weights(batch.data(), n, coords, correctForBinSize));
+      for (Int_t i = 0; i < n; ++i) {
+         x.setVal(xs[i]);
+         y.setVal(ys[i]);
+         const Double_t ref = hist.weight(RooArgSet(x, y), 0, correctForBinSize);
+         EXPECT_DOUBLE_EQ(batch[i], ref) << "point " << i << " correctForBinSize " << correctForBinSize;
+      }
+   }
+}
@@ -0,0 +1,71 @@
+#include <RooFFTConvPdf.h>
+#include <RooRealVar.h>
+#include <RooGaussian.h>
+#include <RooArgSet.h>
+#include <RooMsgService.h>
+
+#include <cmath>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+
+// Evaluate the convolution on a few points of x
+static std::vector<Double_t> Evaluate(RooAbsPdf& pdf, RooRealVar& x)
+{
+   std::vector<Double_t> values;
+   for (Double_t val : {-4., -1.5, 0., 0.7, 2., 5.}) {
+      x.setVal(val);
+      values.push_back(pdf.getVal(RooArgSet(x)));
+   }
+   return values;
+}
+
+// The cached transforms of each input are refreshed when one of its parameters changes
+TEST(RooFFTConvPdf, ParameterChanges)
+{
+   RooMsgService::instance().setGlobalKillBelow(RooFit::WARNING);
+
+   RooRealVar x("x", "x", -10, 10);
+   x.setBins(2000, "cache");
+   RooRealVar mean1("mean1", "mean1", 0.5, -5, 5);
+   RooRealVar sigma1("sigma1", "sigma1", 1., 0.1, 5);
+   RooGaussian physics("physics", "physics", x, mean1, sigma1);
+   RooRealVar mean2("mean2", "mean2", 0., -5, 5);
+   RooRealVar sigma2("sigma2", "sigma2", 0.8, 0.1, 5);
+   RooGaussian resolution("resolution", "resolution", x, mean2, sigma2);
+
+   RooFFTConvPdf conv("conv", "conv", x, physics, resolution);
+   Evaluate(conv, x);
+
+   auto check = [&](const char* step) {
+      // A new convolution p.d.f. fills its cache from scratch
+      RooFFTConvPdf fresh("fresh", "fresh", x, physics, resolution);
+      std::vector<Double_t> cached = Evaluate(conv, x);
+      std::vector<Double_t> expected = Evaluate(fresh, x);
+      ASSERT_EQ(cached.size(), expected.size());
+      for (std::size_t i = 0; i < cached.size(); ++i) {
+         EXPECT_DOUBLE_EQ(cached[i], expected[i]) << step << ", point " << i;
+      }
+
+      // The convolution of two Gaussians is a Gaussian
+      const Double_t mean = mean1.getVal() + mean2.getVal();
+      const Double_t sigma = std::sqrt(sigma1.getVal() * sigma1.getVal() + sigma2.getVal() * sigma2.getVal());
+      std::size_t i = 0;
+      for (Double_t val : {-4., -1.5, 0., 0.7, 2., 5.}) {
+         const Double_t analytical = std::exp(-0.5 * (val - mean) * (val - mean) / (sigma * sigma)) / (std::sqrt(2 * M_PI) * sigma);
+         EXPECT_NEAR(cached[i], analytical, 1.e-3) << step << ", x = " << val;
+         ++i;
+      }
+   };
+
+   sigma1.setVal(1.4);
+   check("physics parameter");
+   sigma2.setVal(0.5);
+   check("resolution parameter");
+   mean1.setVal(-0.3);
+   mean2.setVal(0.2);
+   check("both inputs");
+   sigma1.setVal(1.);
+   check("physics parameter restored");
+}
@@ -0,0 +1,112 @@
+#include <RooFormula.h>
+#include <RooRealVar.h>
+#include <RooCategory.h>
+#include <RooArgList.h>
+#include <RooLinkedList.h>
+#include <RooMsgService.h>
+
+#include <TBufferFile.h>
+#include <TMath.h>
+#include <TNamed.h>
+#include <v5/TFormula.h>
+
+#include "gtest/gtest.h"
+
+
+// Ordinal and name references
+TEST(RooFormula, References)
+{
+   RooRealVar x("x", "x", 2.);
+   RooRealVar y("y", "y", 3.);
+
+   RooFormula ordinal("ordinal", "@0*@1+@0", RooArgList(x, y));
+   ASSERT_TRUE(ordinal.ok());
+   EXPECT_DOUBLE_EQ(ordinal.eval(), 8.);
+
+   RooFormula named("named", "x*y - y", RooArgList(x, y));
+   ASSERT_TRUE(named.ok());
+   EXPECT_DOUBLE_EQ(named.eval(), 3.);
+
+   x.setVal(5.);
+   EXPECT_DOUBLE_EQ(ordinal.eval(), 20.);
+   EXPECT_DOUBLE_EQ(named.eval(), 12.);
+}
+
+// Category states are accessed with '::'
+TEST(RooFormula, CategoryLabels)
+{
+   RooCategory tag("tag", "tag");
+   tag.defineType("Kaon", 3);
+   tag.defineType("Pion", 7);
+   tag.setLabel("Pion");
+
+   RooFormula formula("formula", "(tag==tag::Pion)*10 + tag::Kaon", RooArgList(tag));
+   ASSERT_TRUE(formula.ok());
+   EXPECT_DOUBLE_EQ(formula.eval(), 13.);
+
+   tag.setLabel("Kaon");
+   EXPECT_DOUBLE_EQ(formula.eval(), 3.);
+}
+
+// Functions and namespace members are passed to TFormula
+TEST(RooFormula, Functions)
+{
+   RooRealVar x("x", "x", 0.5);
+
+   RooFormula formula("formula", "TMath::Erf(x) + exp(@0) + TMath::Pi() + pi", RooArgList(x));
+   ASSERT_TRUE(formula.ok());
+   EXPECT_NEAR(formula.eval(), TMath::Erf(0.5) + std::exp(0.5) + 2 * TMath::Pi(), 1.e-12);
+}
+
+// Unresolved identifiers must not bind to TFormula constants or variables
+TEST(RooFormula, Errors)
+{
+   RooMsgService::instance().setGlobalKillBelow(RooFit::FATAL);
+
+   RooRealVar x("x", "x", 2.);
+   RooCategory tag("tag", "tag");
+   tag.defineType("Kaon", 3);
+
+   for (const char *expr : {"x*e", "c", "x+g", "h*k", "sigma", "r", "y", "@2", "tag::Pion", "x::Kaon"}) {
+      RooFormula formula("formula", expr, RooArgList(x, tag));
+      EXPECT_FALSE(formula.ok()) << expr;
+   }
+
+   RooMsgService::instance().setGlobalKillBelow(RooFit::INFO);
+}
+
+// Read the version 1 layout, in which RooFormula derived from ROOT::v5::TFormula. The bases are written
+// by their own streamers and the normalisation set pointer holds a real object, as in old files.
+TEST(RooFormula, ReadVersion1)
+{
+   TBufferFile buf(TBuffer::kWrite);
+
+   UInt_t cntpos = buf.Length();
+   buf << UInt_t(0);
+   buf << Version_t(1);
+
+   ROOT::v5::TFormula oldFormula("oldFormula", "x*2");
+   oldFormula.Streamer(buf);
+
+   RooFormula printable;
+   printable.RooPrintable::Streamer(buf);
+   RooRealVar x("x", "x", 1.);
+   RooArgSet nset(x);
+   buf.WriteObjectAny(&nset, RooArgSet::Class());
+   buf << Bool_t(kTRUE);
+   RooLinkedList labels;
+   labels.Streamer(buf);
+   buf << Bool_t(kTRUE);
+   buf.SetByteCount(cntpos, kTRUE);
+   const Int_t written = buf.Length();
+
+   buf.SetReadMode();
+   buf.SetBufferOffset(0);
+   buf.ResetMap();
+   RooFormula formula;
+   formula.Streamer(buf);
+
+   EXPECT_STREQ(formula.GetName(), "oldFormula");
+   EXPECT_STREQ(formula.GetTitle(), "x*2");
+   EXPECT_EQ(buf.Length(), written);
+}
@@ -0,0 +1,44 @@
+#include <RooMCStudy.h>
+#include <RooRealVar.h>
+#include <RooGaussian.h>
+#include <RooDataSet.h>
+#include <RooArgSet.h>
+#include <RooGlobalFunc.h>
+#include <RooMsgService.h>
+
+#include "gtest/gtest.h"
+
+
+// Generate and fit the same samples with one and with several workers and compare the fitted parameters
+TEST(RooMCStudy, ParallelToysReproducible)
+{
+   RooMsgService::instance().setGlobalKillBelow(RooFit::WARNING);
+
+   RooRealVar x("x", "x", -10, 10);
+   RooRealVar mean("mean", "mean", 1, -5, 5);
+   RooRealVar sigma("sigma", "sigma", 2, 0.1, 5);
+   RooGaussian model("model", "model", x, mean, sigma);
+
+   RooMCStudy serial(model, RooArgSet(x), RooFit::Silence());
+   serial.setToySeed(1234);
+   serial.setParallel(1);
+   serial.generateAndFit(12, 100);
+
+   RooMCStudy parallel(model, RooArgSet(x), RooFit::Silence());
+   parallel.setToySeed(1234);
+   parallel.setParallel(3);
+   parallel.generateAndFit(12, 100);
+
+   const RooDataSet& serialPars = serial.fitParDataSet();
+   const RooDataSet& parallelPars = parallel.fitParDataSet();
+   ASSERT_EQ(serialPars.numEntries(), 12);
+   ASSERT_EQ(parallelPars.numEntries(), serialPars.numEntries());
+   for (Int_t i = 0; i < serialPars.numEntries(); ++i) {
+      const RooArgSet* s = serialPars.get(i);
+      Double_t serialMean = s->getRealValue("mean");
+      Double_t serialSigma = s->getRealValue("sigma");
+      const RooArgSet* p = parallelPars.get(i);
+      EXPECT_EQ(serialMean, p->getRealValue("mean")) << "sample " << i;
+      EXPECT_EQ(serialSigma, p->getRealValue("sigma")) << "sample " << i;
+   }
+}
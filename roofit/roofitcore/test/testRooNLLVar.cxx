@@ -0,0 +1,263 @@
+#include <RooNLLVar.h>
+#include <RooRealVar.h>
+#include <RooDataHist.h>
+#include <RooHistFunc.h>
+#include <RooRealSumPdf.h>
+#include <RooGenericPdf.h>
+#include <RooFormulaVar.h>
+#include <RooProduct.h>
+#include <RooDataSet.h>
+#include <RooCategory.h>
+#include <RooSimultaneous.h>
+#include <RooTrace.h>
+#include <RooArgSet.h>
+#include <RooArgList.h>
+#include <RooMsgService.h>
+
+#include <TMath.h>
+
+#include <cmath>
+#include <memory>
+#include <sstream>
+#include <string>
+
+#include "gtest/gtest.h"
+
+
+// Binned likelihood calculated directly from the p.d.f. values in each bin of the data
+static Double_t BinnedNLL(RooAbsPdf& pdf, RooRealVar& x, RooDataHist& data)
+{
+   Double_t result(0);
+   for (Int_t i = 0; i < data.numEntries(); ++i) {
+      x.setVal(data.get(i)->getRealValue(x.GetName()));
+      const Double_t N = data.weight();
+      const Double_t mu = pdf.getVal() * data.binVolume();
+      if (std::abs(mu) < 1e-10 && std::abs(N) < 1e-10) continue;
+      result -= -mu + N * std::log(mu) - TMath::LnGamma(N + 1);
+   }
+   return result;
+}
+
+// The binned likelihood with cached component values equals the likelihood computed from the p.d.f.
+TEST(RooNLLVar, BinnedLikelihoodCache)
+{
+   RooMsgService::instance().setGlobalKillBelow(RooFit::WARNING);
+
+   RooRealVar x("x", "x", 0, 10);
+   x.setBins(10);
+
+   RooDataHist sigHist("sigHist", "sigHist", RooArgSet(x));
+   RooDataHist bkgHist("bkgHist", "bkgHist", RooArgSet(x));
+   RooDataHist data("data", "data", RooArgSet(x));
+   for (Int_t i = 0; i < 10; ++i) {
+      sigHist.get(i);
+      sigHist.set(std::exp(-0.5 * (i - 4.5) * (i - 4.5) / 2.));
+      bkgHist.get(i);
+      bkgHist.set(10. - 0.5 * i);
+      data.get(i);
+      data.set(12. + (i % 3) + (i == 4 ? 3 : 0));
+   }
+
+   RooHistFunc sig("sig", "sig", RooArgSet(x), sigHist);
+   RooHistFunc bkg("bkg", "bkg", RooArgSet(x), bkgHist);
+   RooRealVar mu("mu", "mu", 1., 0., 10.);
+   RooRealVar bkgNorm("bkgNorm", "bkgNorm", 1., 0., 10.);
+   RooRealSumPdf model("model", "model", RooArgList(sig, bkg), RooArgList(mu, bkgNorm), kTRUE);
+   model.setAttribute("BinnedLikelihood");
+
+   // The dataset is not cloned, such that it can be modified in place
+   RooNLLVar nll("nll", "nll", model, data, kFALSE, 0, 0, 1, RooFit::BulkPartition, kFALSE, kFALSE, kFALSE, kTRUE);
+
+   EXPECT_NEAR(nll.getVal(), BinnedNLL(model, x, data), 1e-9);
+
+   mu.setVal(2.5);
+   EXPECT_NEAR(nll.getVal(), BinnedNLL(model, x, data), 1e-9);
+
+   // Modify the observed counts in place
+   data.get(4);
+   data.set(30.);
+   nll.setValueDirty();
+   EXPECT_NEAR(nll.getVal(), BinnedNLL(model, x, data), 1e-9);
+
+   // Constant term optimization as done by a fit, followed by a change of a constant parameter
+   bkgNorm.setConstant(kTRUE);
+   nll.constOptimizeTestStatistic(RooAbsArg::Activate);
+   EXPECT_NEAR(nll.getVal(), BinnedNLL(model, x, data), 1e-9);
+   bkgNorm.setVal(1.7);
+   nll.constOptimizeTestStatistic(RooAbsArg::ValueChange);
+   EXPECT_NEAR(nll.getVal(), BinnedNLL(model, x, data), 1e-9);
+
+   mu.setVal(0.8);
+   EXPECT_NEAR(nll.getVal(), BinnedNLL(model, x, data), 1e-9);
+}
+
+// A shape change of a node shared by several components recalculates all of them
+TEST(RooNLLVar, BinnedLikelihoodSharedShape)
+{
+   RooMsgService::instance().setGlobalKillBelow(RooFit::WARNING);
+
+   RooRealVar x("x", "x", 0, 10);
+   x.setBins(10);
+
+   RooDataHist sharedHist("sharedHist", "sharedHist", RooArgSet(x));
+   RooDataHist sigHist("sigHist", "sigHist", RooArgSet(x));
+   RooDataHist bkgHist("bkgHist", "bkgHist", RooArgSet(x));
+   RooDataHist data("data", "data", RooArgSet(x));
+   for (Int_t i = 0; i < 10; ++i) {
+      sharedHist.get(i);
+      sharedHist.set(1.);
+      sigHist.get(i);
+      sigHist.set(1. + std::exp(-0.5 * (i - 4.5) * (i - 4.5) / 2.));
+      bkgHist.get(i);
+      bkgHist.set(10. - 0.5 * i);
+      data.get(i);
+      data.set(12. + (i % 3));
+   }
+
+   RooHistFunc shared("shared", "shared", RooArgSet(x), sharedHist);
+   RooHistFunc sigShape("sigShape", "sigShape", RooArgSet(x), sigHist);
+   RooHistFunc bkgShape("bkgShape", "bkgShape", RooArgSet(x), bkgHist);
+   RooProduct sig("sig", "sig", RooArgList(shared, sigShape));
+   RooProduct bkg("bkg", "bkg", RooArgList(shared, bkgShape));
+   RooRealVar mu("mu", "mu", 1., 0., 10.);
+   RooRealVar bkgNorm("bkgNorm", "bkgNorm", 1., 0., 10.);
+   RooRealSumPdf model("model", "model", RooArgList(sig, bkg), RooArgList(mu, bkgNorm), kTRUE);
+   model.setAttribute("BinnedLikelihood");
+
+   RooNLLVar nll("nll", "nll", model, data, kFALSE, 0, 0, 1, RooFit::BulkPartition, kFALSE, kFALSE, kFALSE, kTRUE);
+   EXPECT_NEAR(nll.getVal(), BinnedNLL(model, x, data), 1e-9);
+
+   // The histogram is shared with the internal clone of the model, which is told about the change
+   for (Int_t i = 0; i < 10; ++i) {
+      sharedHist.get(i);
+      sharedHist.set(0.5 + 0.1 * i);
+   }
+   RooArgSet nodes;
+   nll.function().treeNodeServerList(&nodes);
+   RooAbsArg* sharedClone = nodes.find("shared");
+   ASSERT_NE(sharedClone, nullptr);
+   sharedClone->setShapeDirty();
+   nll.setValueDirty();
+
+   EXPECT_NEAR(nll.getVal(), BinnedNLL(model, x, data), 1e-9);
+   EXPECT_FALSE(sharedClone->isShapeDirty());
+}
+
+// Constant expressions that do not depend on the observables are folded by the constant term
+// optimization. The likelihood follows changes of constant parameters in these expressions.
+TEST(RooNLLVar, FoldedConstantTerms)
+{
+   RooMsgService::instance().setGlobalKillBelow(RooFit::WARNING);
+
+   RooRealVar x("x", "x", -5, 5);
+   RooRealVar a("a", "a", 0.5);
+   RooRealVar b("b", "b", 0.2);
+   RooRealVar sigma("sigma", "sigma", 1.5, 0.1, 10);
+   RooFormulaVar mean("mean", "a+b", RooArgList(a, b));
+   RooGenericPdf pdf("pdf", "exp(-0.5*((x-mean)/sigma)^2)", RooArgList(x, mean, sigma));
+
+   RooDataSet data("data", "data", RooArgSet(x));
+   for (Int_t i = 0; i < 50; ++i) {
+      x.setVal(-4.9 + 0.2 * i);
+      data.add(RooArgSet(x));
+   }
+
+   // Reference likelihood without constant term optimization
+   RooNLLVar ref("ref", "ref", pdf, data);
+   RooNLLVar nll("nll", "nll", pdf, data);
+   nll.constOptimizeTestStatistic(RooAbsArg::Activate);
+   EXPECT_NEAR(nll.getVal(), ref.getVal(), 1e-9);
+
+   // Change of a constant parameter as signalled by the minimizer
+   const Double_t folded = nll.getVal();
+   a.setVal(1.3);
+   nll.constOptimizeTestStatistic(RooAbsArg::ValueChange);
+   const Double_t refolded = nll.getVal();
+   EXPECT_GT(std::abs(refolded - folded), 1.);
+   EXPECT_NEAR(refolded, ref.getVal(), 1e-9);
+
+   // Repeated activation of the optimization with the filled cache
+   b.setVal(-0.8);
+   nll.constOptimizeTestStatistic(RooAbsArg::Activate);
+   EXPECT_GT(std::abs(nll.getVal() - refolded), 1.);
+   EXPECT_NEAR(nll.getVal(), ref.getVal(), 1e-9);
+
+   sigma.setVal(2.1);
+   EXPECT_NEAR(nll.getVal(), ref.getVal(), 1e-9);
+}
+
+// Return the number of evaluations in the evaluation profile for the node "className::name"
+static Long64_t ProfiledEvals(const std::string& node)
+{
+   std::ostringstream os;
+   RooTrace::printEvalProfile(os, 0);
+   std::istringstream is(os.str());
+   std::string line;
+   while (std::getline(is, line)) {
+      std::istringstream fields(line);
+      std::string name;
+      Long64_t nCalls(0), nEvals(0);
+      if (fields >> name >> nCalls >> nEvals && name == node) return nEvals;
+   }
+   return 0;
+}
+
+// A simultaneous likelihood only recalculates the components whose parameters changed
+TEST(RooNLLVar, SimultaneousComponentCache)
+{
+   RooMsgService::instance().setGlobalKillBelow(RooFit::WARNING);
+
+   RooRealVar x("x", "x", -5, 5);
+   RooCategory cat("cat", "cat");
+   cat.defineType("a");
+   cat.defineType("b");
+   cat.defineType("c");
+   RooRealVar sigma("sigma", "sigma", 1.5, 0.1, 10);
+   RooRealVar ma("ma", "ma", -1, -5, 5);
+   RooRealVar mb("mb", "mb", 0, -5, 5);
+   RooRealVar mc("mc", "mc", 1, -5, 5);
+   RooGenericPdf pdfA("pdfA", "exp(-0.5*((x-ma)/sigma)^2)", RooArgList(x, ma, sigma));
+   RooGenericPdf pdfB("pdfB", "exp(-0.5*((x-mb)/sigma)^2)", RooArgList(x, mb, sigma));
+   RooGenericPdf pdfC("pdfC", "exp(-0.5*((x-mc)/sigma)^2)", RooArgList(x, mc, sigma));
+   RooSimultaneous sim("sim", "sim", cat);
+   sim.addPdf(pdfA, "a");
+   sim.addPdf(pdfB, "b");
+   sim.addPdf(pdfC, "c");
+
+   RooDataSet data("data", "data", RooArgSet(x, cat));
+   for (Int_t i = 0; i < 60; ++i) {
+      x.setVal(-4.9 + 0.16 * i);
+      cat.setIndex(i % 3);
+      data.add(RooArgSet(x, cat));
+   }
+
+   RooNLLVar nll("nll", "nll", sim, data);
+   nll.getVal();
+
+   // Change of a parameter of a single component
+   RooTrace::resetEvalProfile();
+   RooTrace::profileEval(kTRUE);
+   ma.setVal(-0.5);
+   const Double_t value = nll.getVal();
+   RooTrace::profileEval(kFALSE);
+   EXPECT_EQ(ProfiledEvals("RooNLLVar::a"), 1);
+   EXPECT_EQ(ProfiledEvals("RooNLLVar::b"), 0);
+   EXPECT_EQ(ProfiledEvals("RooNLLVar::c"), 0);
+
+   RooNLLVar ref("ref", "ref", sim, data);
+   EXPECT_NEAR(value, ref.getVal(), 1e-9);
+
+   // Change of a parameter shared by all components
+   RooTrace::resetEvalProfile();
+   RooTrace::profileEval(kTRUE);
+   sigma.setVal(2.);
+   const Double_t value2 = nll.getVal();
+   RooTrace::profileEval(kFALSE);
+   EXPECT_EQ(ProfiledEvals("RooNLLVar::a"), 1);
+   EXPECT_EQ(ProfiledEvals("RooNLLVar::b"), 1);
+   EXPECT_EQ(ProfiledEvals("RooNLLVar::c"), 1);
+   RooTrace::resetEvalProfile();
+
+   RooNLLVar ref2("ref2", "ref2", sim, data);
+   EXPECT_NEAR(value2, ref2.getVal(), 1e-9);
+}
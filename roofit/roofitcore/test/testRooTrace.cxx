@@ -0,0 +1,66 @@
+#include <RooTrace.h>
+#include <RooMinimizer.h>
+#include <RooGaussian.h>
+#include <RooRealVar.h>
+#include <RooDataSet.h>
+#include <RooArgSet.h>
+#include <RooRandom.h>
+#include <RooMsgService.h>
+
+#include <memory>
+#include <sstream>
+#include <string>
+
+#include "gtest/gtest.h"
+
+
+// Return the number of calls and evaluations printed for the node "className::name"
+static bool FindProfileEntry(const std::string& profile, const std::string& node, Long64_t& nCalls, Long64_t& nEvals)
+{
+   std::istringstream is(profile);
+   std::string line;
+   while (std::getline(is, line)) {
+      std::istringstream fields(line);
+      std::string name;
+      if (fields >> name >> nCalls >> nEvals && name == node) return true;
+   }
+   return false;
+}
+
+// The evaluation profile of a fit reports the calls and evaluations of its nodes, also after
+// the likelihood was deleted
+TEST(RooTrace, EvalProfileOfFit)
+{
+   RooMsgService::instance().setGlobalKillBelow(RooFit::WARNING);
+   RooRandom::randomGenerator()->SetSeed(1);
+
+   RooRealVar x("x", "x", -10, 10);
+   RooRealVar mean("mean", "mean", 1, -5, 5);
+   RooRealVar sigma("sigma", "sigma", 2, 0.1, 10);
+   RooGaussian gauss("gauss", "gauss", x, mean, sigma);
+   std::unique_ptr<RooDataSet> data(gauss.generate(x, 200));
+
+   std::unique_ptr<RooAbsReal> nll(gauss.createNLL(*data));
+   std::string nllNode = std::string(nll->IsA()->GetName()) + "::" + nll->GetName();
+   {
+      RooMinimizer minim(*nll);
+      minim.setPrintLevel(-1);
+      minim.setEvalProfile();
+      minim.migrad();
+   }
+   nll.reset();
+
+   std::ostringstream os;
+   RooTrace::printEvalProfile(os, 0);
+
+   Long64_t nCalls(0), nEvals(0);
+   ASSERT_TRUE(FindProfileEntry(os.str(), "RooGaussian::gauss", nCalls, nEvals)) << os.str();
+   EXPECT_GT(nCalls, 0);
+   EXPECT_GT(nEvals, 0);
+
+   ASSERT_TRUE(FindProfileEntry(os.str(), nllNode, nCalls, nEvals)) << os.str();
+   EXPECT_GT(nCalls, 0);
+   EXPECT_GT(nEvals, 0);
+
+   RooTrace::resetEvalProfile();
+}
@@ -0,0 +1,144 @@
+#include <RooWorkspace.h>
+#include <RooRealVar.h>
+#include <RooGaussian.h>
+#include <RooDataSet.h>
+#include <RooDataHist.h>
+#include <RooArgSet.h>
+#include <RooRandom.h>
+#include <RooMsgService.h>
+
+#include <TFile.h>
+#include <TSystem.h>
+
+#include <memory>
+
+#include "gtest/gtest.h"
+
+
+// Write a workspace with two datasets, stored as separate buffers, and read it back
+class RooWorkspaceLazyData : public ::testing::Test {
+protected:
+   void SetUp() override
+   {
+      RooMsgService::instance().setGlobalKillBelow(RooFit::WARNING);
+
+      RooWorkspace ws("ws");
+      ws.factory("Gaussian::gauss(x[-5,5],mean[0.5],sigma[1.2])");
+      RooRealVar *x = ws.var("x");
+      RooRandom::randomGenerator()->SetSeed(10);
+      std::unique_ptr<RooDataSet> unbinned(ws.pdf("gauss")->generate(*x, 200));
+      unbinned->SetName("unbinned");
+      x->setBins(20);
+      RooDataHist binned("binned", "binned", RooArgSet(*x), *unbinned);
+      ws.import(*unbinned);
+      ws.import(binned);
+
+      fSum = unbinned->sumEntries();
+      fFirst = unbinned->get(0)->getRealValue("x");
+      fLast = unbinned->get(199)->getRealValue("x");
+
+      ws.setLazyDataIO();
+      TFile file(fFileName, "RECREATE");
+      ws.Write();
+   }
+
+   void TearDown() override
+   {
+      gSystem->Unlink(fFileName);
+      gSystem->Unlink(fRewriteName);
+   }
+
+   void CheckData(const RooWorkspace &ws)
+   {
+      RooAbsData *unbinned = ws.data("unbinned");
+      RooAbsData *binned = ws.data("binned");
+      ASSERT_TRUE(unbinned && binned);
+      ASSERT_EQ(unbinned->numEntries(), 200);
+      EXPECT_EQ(unbinned->get(0)->getRealValue("x"), fFirst);
+      EXPECT_EQ(unbinned->get(199)->getRealValue("x"), fLast);
+      EXPECT_EQ(binned->numEntries(), 20);
+      EXPECT_DOUBLE_EQ(binned->sumEntries(), fSum);
+   }
+
+   const char *fFileName = "testRooWorkspace_lazy.root";
+   const char *fRewriteName = "testRooWorkspace_lazy2.root";
+   Double_t fSum;
+   Double_t fFirst;
+   Double_t fLast;
+};
+
+TEST_F(RooWorkspaceLazyData, StreamerInfos)
+{
+   TFile file(fFileName);
+   ASSERT_TRUE(file.GetStreamerInfoList()->FindObject("RooDataSet"));
+   EXPECT_TRUE(file.GetStreamerInfoList()->FindObject("RooDataHist"));
+   EXPECT_TRUE(file.GetStreamerInfoList()->FindObject("RooVectorDataStore"));
+}
+
+TEST_F(RooWorkspaceLazyData, Access)
+{
+   TFile file(fFileName);
+   RooWorkspace *ws = static_cast<RooWorkspace *>(file.Get("ws"));
+   ASSERT_TRUE(ws);
+
+   // Lists the datasets that are not loaded yet
+   ws->Print();
+   EXPECT_FALSE(ws->isDataLoaded("unbinned"));
+   EXPECT_FALSE(ws->isDataLoaded("binned"));
+
+   // Only the accessed dataset is loaded
+   ASSERT_TRUE(ws->data("unbinned"));
+   EXPECT_TRUE(ws->isDataLoaded("unbinned"));
+   EXPECT_FALSE(ws->isDataLoaded("binned"));
+
+   CheckData(*ws);
+   EXPECT_TRUE(ws->isDataLoaded("binned"));
+   EXPECT_EQ(ws->allData().size(), 2u);
+   ws->Print();
+   delete ws;
+}
+
+TEST_F(RooWorkspaceLazyData, AllData)
+{
+   TFile file(fFileName);
+   RooWorkspace *ws = static_cast<RooWorkspace *>(file.Get("ws"));
+   ASSERT_TRUE(ws);
+
+   EXPECT_EQ(ws->allData().size(), 2u);
+   CheckData(*ws);
+   delete ws;
+}
+
+TEST_F(RooWorkspaceLazyData, Copy)
+{
+   TFile file(fFileName);
+   RooWorkspace *ws = static_cast<RooWorkspace *>(file.Get("ws"));
+   ASSERT_TRUE(ws);
+
+   RooWorkspace copy(*ws);
+   delete ws;
+   CheckData(copy);
+}
+
+// Write a lazily read workspace in which only one of the datasets was loaded
+TEST_F(RooWorkspaceLazyData, Rewrite)
+{
+   {
+      TFile file(fFileName);
+      RooWorkspace *ws = static_cast<RooWorkspace *>(file.Get("ws"));
+      ASSERT_TRUE(ws);
+      ASSERT_TRUE(ws->data("unbinned"));
+
+      ws->setLazyDataIO();
+      TFile rewrite(fRewriteName, "RECREATE");
+      ws->Write();
+      delete ws;
+   }
+
+   TFile file(fRewriteName);
+   EXPECT_TRUE(file.GetStreamerInfoList()->FindObject("RooDataHist"));
+   RooWorkspace *ws = static_cast<RooWorkspace *>(file.Get("ws"));
+   ASSERT_TRUE(ws);
+   CheckData(*ws);
+   delete ws;
+}
@@ -21,6 +21,7 @@ class RooRealVar;
 class TGraphErrors;
 
 #include <memory>
+#include <vector>
 
 
 namespace RooStats {
@@ -137,6 +138,9 @@ public:
    // set numerical error in test statistic evaluation (default is zero)
    void SetNumErr(double err) { fNumErr = err; }
 
+   // run the points of a fixed scan in n local worker processes (default is 1, i.e. serial)
+   void SetNWorkers(int n) { fNWorkers = n; }
+
    // set flag to close proof for every new run
    static void SetCloseProof(Bool_t flag);
 
@@ -154,6 +158,12 @@ protected:
    // run the hybrid at a single point
    HypoTestResult * Eval( HypoTestCalculatorGeneric &hc, bool adaptive , double clsTarget) const;
 
+   // run the points of a fixed scan in local worker processes
+   bool RunParallelScan(const std::vector<double> & xValues) const;
+
+   // add the result for one point to fResults, merging it with the previous point if at the same value
+   void AddPointResult(double rVal, HypoTestResult * result) const;
+
    // helper functions
    static RooRealVar * GetVariableToScan(const HypoTestCalculatorGeneric &hc);
    static void CheckInputModels(const HypoTestCalculatorGeneric &hc, const RooRealVar & scanVar);
@@ -190,6 +200,7 @@ private:
    double fXmin;
    double fXmax;
    double fNumErr;
+   int fNWorkers;  //! number of local worker processes for fixed scans
 
 protected:
 
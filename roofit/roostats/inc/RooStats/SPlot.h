@@ -59,6 +59,9 @@ namespace RooStats{
 
     Double_t GetSWeight(Int_t numEvent, const char* sVariable) const;
 
+    // set the number of local worker processes used by AddSWeight to evaluate the species pdfs (default is 1)
+    void SetNWorkers(Int_t n) { fNWorkers = n; }
+
 
 
   protected:
@@ -73,6 +76,8 @@ namespace RooStats{
 
     RooDataSet* fSData;
 
+    Int_t fNWorkers;  //! number of local worker processes
+
     ClassDef(SPlot,1)   // Class used for making sPlots
 
 
@@ -54,6 +54,7 @@ class NuisanceParametersSampler {
       }
 
       void NextPoint(RooArgSet& nuisPoint, Double_t& weight);
+      void Skip(Int_t nPoints);
 
    protected:
       void Refresh();
@@ -232,6 +233,11 @@ class ToyMCSampler: public TestStatSampler {
       // calling with argument or NULL deactivates proof
       void SetProofConfig(ProofConfig *pc = NULL) { fProofConfig = pc; }
 
+      // run the toys in n local worker processes (n <= 1 runs serially in this process)
+      void SetNWorkers(Int_t n) { fNWorkers = n; }
+      // seed from which the seeds of the individual toys are derived (0 disables reseeding)
+      void SetToySeed(UInt_t seed) { fToySeed = seed; }
+
       void SetProtoData(const RooDataSet* d) { fProtoData = d; }
 
    protected:
@@ -241,6 +247,9 @@ class ToyMCSampler: public TestStatSampler {
       // helper for GenerateToyData
       RooAbsData* Generate(RooAbsPdf &pdf, RooArgSet &observables, const RooDataSet *protoData=NULL, int forceEvents=0) const;
 
+      // parallel run in forked local processes
+      RooDataSet* GetSamplingDistributionsLocalWorkers(RooArgSet& paramPoint);
+
       // helper method for clearing  the cache
       virtual void ClearCache();
 
@@ -277,6 +286,10 @@ class ToyMCSampler: public TestStatSampler {
       const RooDataSet *fProtoData; // in dev
 
       ProofConfig *fProofConfig;   //!
+      Int_t fNWorkers;             //! number of local worker processes
+      UInt_t fToySeed;             //! base seed for per-toy reseeding (0 = no reseeding)
+      Int_t fFirstToy;             //! number of the first toy run by this instance
+      Int_t fNToysTotal;           //! number of toys of the whole run when running a block of it (0 = fNToys)
 
       mutable NuisanceParametersSampler *fNuisanceParametersSampler; //!
 
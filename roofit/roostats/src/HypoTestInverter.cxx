@@ -26,6 +26,10 @@ optimally the curve and it will stop until the desired precision is obtained.
 The confidence level value at a given point can be done via  HypoTestInverter::RunOnePoint.
 The class can scan the CLs+b values or alternatively CLs
 (if the method HypoTestInverter::UseCLs has been called).
+The points of a fixed scan are independent and can be run in parallel local
+processes with HypoTestInverter::SetNWorkers. With a toy-based calculator the
+toys of a parallel scan differ from those of a serial scan, see
+HypoTestInverter::RunParallelScan.
 
 Contributions to this class have been written by Giovanni Petrucciani and Annapaola Decosa
 */
@@ -67,6 +71,11 @@ Contributions to this class have been written by Giovanni Petrucciani and Annapa
 
 #include "RooStats/ProofConfig.h"
 
+#ifndef _WIN32
+#include "ROOT/TProcessExecutor.hxx"
+#include "ROOT/TSeq.hxx"
+#endif
+
 ClassImp(RooStats::HypoTestInverter);
 
 using namespace RooStats;
@@ -175,7 +184,8 @@ HypoTestInverter::HypoTestInverter( ) :
    fVerbose(0),
    fCalcType(kUndefined),
    fNBins(0), fXmin(1), fXmax(1),
-   fNumErr(0)
+   fNumErr(0),
+   fNWorkers(1)
 {
 }
 
@@ -201,7 +211,8 @@ HypoTestInverter::HypoTestInverter( HypoTestCalculatorGeneric& hc,
    fVerbose(0),
    fCalcType(kUndefined),
    fNBins(0), fXmin(1), fXmax(1),
-   fNumErr(0)
+   fNumErr(0),
+   fNWorkers(1)
 {
 
    if (!fScannedVariable) {
@@ -254,7 +265,8 @@ HypoTestInverter::HypoTestInverter( HybridCalculator& hc,
    fVerbose(0),
    fCalcType(kHybrid),
    fNBins(0), fXmin(1), fXmax(1),
-   fNumErr(0)
+   fNumErr(0),
+   fNWorkers(1)
 {
 
    if (!fScannedVariable) {
@@ -287,7 +299,8 @@ HypoTestInverter::HypoTestInverter( FrequentistCalculator& hc,
    fVerbose(0),
    fCalcType(kFrequentist),
    fNBins(0), fXmin(1), fXmax(1),
-   fNumErr(0)
+   fNumErr(0),
+   fNWorkers(1)
 {
 
    if (!fScannedVariable) {
@@ -319,7 +332,8 @@ HypoTestInverter::HypoTestInverter( AsymptoticCalculator& hc,
    fVerbose(0),
    fCalcType(kAsymptotic),
    fNBins(0), fXmin(1), fXmax(1),
-   fNumErr(0)
+   fNumErr(0),
+   fNWorkers(1)
 {
 
    if (!fScannedVariable) {
@@ -352,7 +366,8 @@ HypoTestInverter::HypoTestInverter( RooAbsData& data, ModelConfig &sbModel, Mode
    fVerbose(0),
    fCalcType(type),
    fNBins(0), fXmin(1), fXmax(1),
-   fNumErr(0)
+   fNumErr(0),
+   fNWorkers(1)
 {
    if(fCalcType==kFrequentist) fHC.reset(new FrequentistCalculator(data, bModel, sbModel));
    if(fCalcType==kHybrid) fHC.reset( new HybridCalculator(data, bModel, sbModel)) ;
@@ -405,6 +420,7 @@ HypoTestInverter & HypoTestInverter::operator= (const HypoTestInverter & rhs) {
    fXmin = rhs.fXmin;
    fXmax = rhs.fXmax;
    fNumErr = rhs.fNumErr;
+   fNWorkers = rhs.fNWorkers;
 
    return *this;
 }
@@ -637,17 +653,20 @@ bool HypoTestInverter::RunFixedScan( int nBins, double xMin, double xMax, bool s
                                           << xMax << std::endl;
    }
 
-   double thisX = xMin;
-   for (int i=0; i<nBins; i++) {
+   std::vector<double> xValues(nBins, xMin);
+   for (int i=1; i<nBins; i++) {  // avoids case of nBins = 1
+      if (scanLog)
+         xValues[i] = exp(  log(xMin) +  i*(log(xMax)-log(xMin))/(nBins-1)  );  // scan in log x
+      else
+         xValues[i] = xMin + i*(xMax-xMin)/(nBins-1);          // linear scan in x
+   }
 
-      if (i > 0) { // avoids case of nBins = 1
-         if (scanLog)
-            thisX = exp(  log(xMin) +  i*(log(xMax)-log(xMin))/(nBins-1)  );  // scan in log x
-         else
-            thisX = xMin + i*(xMax-xMin)/(nBins-1);          // linear scan in x
-      }
+   if (fNWorkers > 1 && nBins > 1)
+      return RunParallelScan(xValues);
+
+   for (int i=0; i<nBins; i++) {
 
-      bool status = RunOnePoint(thisX);
+      bool status = RunOnePoint(xValues[i]);
 
       // check if failed status
       if ( status==false ) {
@@ -659,6 +678,86 @@ bool HypoTestInverter::RunFixedScan( int nBins, double xMin, double xMax, bool s
    return true;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Run the points of a fixed scan in fNWorkers forked local processes.
+/// The scan points are independent, so each one is run as a separate task and
+/// the results are added to the HypoTestInverterResult in scan order.
+/// The random generator of each task is seeded with a seed derived from a base
+/// seed drawn in the master and from the index of the point, so the toys do not
+/// depend on the number of workers. They differ however from the toys of a serial
+/// scan, in which the points share one random sequence: with a toy-based
+/// calculator the results agree with a serial scan only within the toy
+/// statistical uncertainty. Asymptotic calculators give the same results.
+/// The calculator should not be configured to use PROOF in this case.
+
+bool HypoTestInverter::RunParallelScan(const std::vector<double> & xValues) const
+{
+#ifndef _WIN32
+   const unsigned int nPoints = xValues.size();
+   const unsigned int nWorkers = std::min<unsigned int>(fNWorkers, nPoints);
+   const UInt_t baseSeed = RooRandom::randomGenerator()->Integer(TMath::Limits<unsigned int>::Max());
+
+   oocoutP((TObject*)0,Eval) << "HypoTestInverter::RunFixedScan - running " << nPoints << " points in "
+                             << nWorkers << " local worker processes" << std::endl;
+
+   // save old value, the workers modify only their own copy of the model
+   const double oldValue = fScannedVariable->getVal();
+
+   auto runPoint = [&](unsigned int i) -> HypoTestResult* {
+      RooRandom::randomGenerator()->SetSeed(RooRandom::derivedSeed(baseSeed, i));
+      fScannedVariable->setVal(xValues[i]);
+      const ModelConfig * sbModel = fCalculator0->GetNullModel();
+      const_cast<ModelConfig*>(sbModel)->SetSnapshot(RooArgSet(*fScannedVariable));
+
+      if (fVerbose > 0)
+         oocoutP((TObject*)0,Eval) << "Running for " << fScannedVariable->GetName() << " = " << fScannedVariable->getVal() << endl;
+
+      return Eval(*fCalculator0,false,-1);
+   };
+
+   ROOT::TProcessExecutor workers(nWorkers);
+   std::vector<HypoTestResult*> results = workers.Map(runPoint, ROOT::TSeqU(nPoints));
+
+   bool status = true;
+   for (unsigned int i = 0; i < nPoints; ++i) {
+      HypoTestResult * result = results[i];
+      if (!status || !result) {
+         if (status)
+            oocoutE((TObject*)0,Eval) << "HypoTestInverter - Error running point " << fScannedVariable->GetName() << " = "
+                                      << xValues[i] << endl;
+         status = false;
+         delete result;
+         continue;
+      }
+      // the toy counter of the workers is lost
+      if (result->GetNullDistribution() && result->GetAltDistribution())
+         fTotalToysRun += (result->GetAltDistribution()->GetSize() + result->GetNullDistribution()->GetSize());
+      if (TMath::IsNaN(result->NullPValue() ) && TMath::IsNaN(result->AlternatePValue() ) ) {
+         oocoutW((TObject*)0,Eval) << "HypoTestInverter - Skip invalid result for  point " << fScannedVariable->GetName() << " = " <<
+            xValues[i] << endl;
+         delete result;
+         continue;
+      }
+      AddPointResult(xValues[i], result);
+   }
+
+   fScannedVariable->setVal(oldValue);
+
+   if (!status)
+      std::cout << "\t\tLoop interrupted because of failed status\n";
+   return status;
+#else
+   oocoutW((TObject*)0,InputArguments) << "HypoTestInverter::RunFixedScan - parallel scans are not supported on this platform, running serially." << endl;
+   for (auto x : xValues) {
+      if (!RunOnePoint(x)) {
+         std::cout << "\t\tLoop interrupted because of failed status\n";
+         return false;
+      }
+   }
+   return true;
+#endif
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// run only one point at the given POI value
 
@@ -713,6 +812,22 @@ bool HypoTestInverter::RunOnePoint( double rVal, bool adaptive, double clTarget)
       return true;  // need to return true to avoid breaking the scan loop
    }
 
+   AddPointResult(rVal, result);
+
+      // std::cout << "computed value for poi  " << rVal  << " : " << fResults->GetYValue(fResults->ArraySize()-1)
+      //        << " +/- " << fResults->GetYError(fResults->ArraySize()-1) << endl;
+
+   fScannedVariable->setVal(oldValue);
+
+   return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// add the result for the given POI value to fResults. If the last point of the
+/// result has the same POI value the two results are merged.
+
+void HypoTestInverter::AddPointResult(double rVal, HypoTestResult * result) const
+{
    double lastXtested;
    if ( fResults->ArraySize()!=0 ) lastXtested = fResults->GetXValue(fResults->ArraySize()-1);
    else lastXtested = -999;
@@ -741,13 +856,6 @@ bool HypoTestInverter::RunOnePoint( double rVal, bool adaptive, double clTarget)
      fResults->fYObjects.Add(result);
 
    }
-
-      // std::cout << "computed value for poi  " << rVal  << " : " << fResults->GetYValue(fResults->ArraySize()-1)
-      //        << " +/- " << fResults->GetYError(fResults->ArraySize()-1) << endl;
-
-   fScannedVariable->setVal(oldValue);
-
-   return true;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -43,6 +43,10 @@
    the pdf, and a list of the yield variables.  The SPlot Class
    will calculate SWeights and include these as columns in the RooDataSet.
 
+   For large data sets, the evaluation of the species pdfs for all events
+   can be spread over several local processes with SPlot::SetNWorkers(),
+   which applies to the sWeights computed by AddSWeight() afterwards.
+
 */
 
 #include <vector>
@@ -58,6 +62,12 @@
 
 
 #include "TMatrixD.h"
+#include "TVectorD.h"
+
+#ifndef _WIN32
+#include "ROOT/TProcessExecutor.hxx"
+#include "ROOT/TSeq.hxx"
+#endif
 
 
 ClassImp(RooStats::SPlot); ;
@@ -78,7 +88,7 @@ SPlot::~SPlot()
 /// Default constructor
 
 SPlot::SPlot():
-  TNamed()
+  TNamed(), fNWorkers(1)
 {
   RooArgList Args;
 
@@ -91,7 +101,7 @@ SPlot::SPlot():
 ////////////////////////////////////////////////////////////////////////////////
 
 SPlot::SPlot(const char* name, const char* title):
-  TNamed(name, title)
+  TNamed(name, title), fNWorkers(1)
 {
   RooArgList Args;
 
@@ -106,7 +116,7 @@ SPlot::SPlot(const char* name, const char* title):
 ///No sWeighted variables are present
 
 SPlot::SPlot(const char* name, const char* title, const RooDataSet &data):
-  TNamed(name, title)
+  TNamed(name, title), fNWorkers(1)
 {
   RooArgList Args;
 
@@ -119,7 +129,7 @@ SPlot::SPlot(const char* name, const char* title, const RooDataSet &data):
 /// Copy Constructor from another SPlot
 
 SPlot::SPlot(const SPlot &other):
-  TNamed(other)
+  TNamed(other), fNWorkers(other.fNWorkers)
 {
   RooArgList Args = (RooArgList) other.GetSWeightVars();
 
@@ -134,7 +144,7 @@ SPlot::SPlot(const SPlot &other):
 SPlot::SPlot(const char* name, const char* title, RooDataSet& data, RooAbsPdf* pdf,
         const RooArgList &yieldsList, const RooArgSet &projDeps,
         bool includeWeights, bool cloneData, const char* newName):
-  TNamed(name, title)
+  TNamed(name, title), fNWorkers(1)
 {
    if(cloneData == 1) {
     fSData = (RooDataSet*) data.Clone(newName);
@@ -420,6 +430,24 @@ void SPlot::AddSWeight( RooAbsPdf* pdf, const RooArgList &yieldsTmp,
   std::vector<std::vector<Double_t> > pdfvalues(numevents,std::vector<Double_t>(nspec,0)) ;
 
 
+  //Check that range of yields is at least (0,1), and fix otherwise
+  for(Int_t k = 0; k < nspec; ++k)
+    {
+      if(yieldvars[k]->getMin() > 0)
+   {
+     coutW(InputArguments)  << "Minimum Range for " << yieldvars[k]->GetName() << " must be 0.  ";
+     coutW(InputArguments)  << "Setting min range to 0" << std::endl;
+     yieldvars[k]->setMin(0);
+   }
+
+      if(yieldvars[k]->getMax() < 1)
+   {
+     coutW(InputArguments)  << "Maximum Range for " << yieldvars[k]->GetName() << " must be 1.  ";
+     coutW(InputArguments)  << "Setting max range to 1" << std::endl;
+     yieldvars[k]->setMax(1);
+   }
+    }
+
   // set all yield to zero
   for(Int_t m=0; m<nspec; ++m) yieldvars[m]->setVal(0) ;
 
@@ -432,45 +460,69 @@ void SPlot::AddSWeight( RooAbsPdf* pdf, const RooArgList &yieldsTmp,
 
   RooArgSet * pdfvars = pdf->getVariables();
 
-  for (Int_t ievt = 0; ievt <numevents; ievt++)
-    {
-      //   if (ievt % 100 == 0)
-      //  coutP(Eval)  << ".";
-
-
-      //FIX THIS PART, EVALUATION PROGRESS!!
-
-      RooStats::SetParameters(fSData->get(ievt), pdfvars);
-
-      //   RooArgSet row(*fSData->get(ievt));
-
-      for(Int_t k = 0; k < nspec; ++k)
-   {
-     //Check that range of yields is at least (0,1), and fix otherwise
-     if(yieldvars[k]->getMin() > 0)
-       {
-         coutW(InputArguments)  << "Minimum Range for " << yieldvars[k]->GetName() << " must be 0.  ";
-         coutW(InputArguments)  << "Setting min range to 0" << std::endl;
-         yieldvars[k]->setMin(0);
-       }
+  // evaluate the species pdfs for events [first,last) into out[(ievt-first)*nspec+k]
+  auto evalPdfValues = [&](Int_t first, Int_t last, Double_t* out) {
+    for (Int_t ievt = first; ievt < last; ievt++)
+      {
+   RooStats::SetParameters(fSData->get(ievt), pdfvars);
 
-     if(yieldvars[k]->getMax() < 1)
-       {
-         coutW(InputArguments)  << "Maximum Range for " << yieldvars[k]->GetName() << " must be 1.  ";
-         coutW(InputArguments)  << "Setting max range to 1" << std::endl;
-         yieldvars[k]->setMax(1);
-       }
-
-     // set this yield to 1
-     yieldvars[k]->setVal( 1 ) ;
-     // evaluate the pdf
-     Double_t f_k = pdf->getVal(&vars) ;
-     pdfvalues[ievt][k] = f_k ;
-     if( !(f_k>1 || f_k<1) )
-       coutW(InputArguments) << "Strange pdf value: " << ievt << " " << k << " " << f_k << std::endl ;
-     yieldvars[k]->setVal( 0 ) ;
-   }
+   for(Int_t k = 0; k < nspec; ++k)
+     {
+       // set this yield to 1
+       yieldvars[k]->setVal( 1 ) ;
+       // evaluate the pdf
+       Double_t f_k = pdf->getVal(&vars) ;
+       out[(ievt-first)*nspec+k] = f_k ;
+       if( !(f_k>1 || f_k<1) )
+         coutW(InputArguments) << "Strange pdf value: " << ievt << " " << k << " " << f_k << std::endl ;
+       yieldvars[k]->setVal( 0 ) ;
+     }
+      }
+  };
+
+  Bool_t evaluated(kFALSE) ;
+#ifndef _WIN32
+  if (fNWorkers > 1 && numevents > 1) {
+
+    // Each worker evaluates a contiguous block of events in a forked copy of the pdf
+    const Int_t nWorkers = std::min(fNWorkers, numevents) ;
+    coutI(Eval) << "Evaluating species pdfs for " << numevents << " events in " << nWorkers << " local worker processes" << std::endl ;
+
+    auto runBlock = [&](UInt_t iWorker) {
+      const Int_t first = Long64_t(numevents) * iWorker / nWorkers ;
+      const Int_t last = Long64_t(numevents) * (iWorker + 1) / nWorkers ;
+      TVectorD* out = new TVectorD((last - first) * nspec) ;
+      evalPdfValues(first, last, out->GetMatrixArray()) ;
+      return out ;
+    };
+
+    ROOT::TProcessExecutor workers(nWorkers) ;
+    std::vector<TVectorD*> results = workers.Map(runBlock, ROOT::TSeqU(nWorkers)) ;
+
+    evaluated = kTRUE ;
+    for (UInt_t iWorker = 0; iWorker < results.size(); ++iWorker) {
+      const Int_t first = Long64_t(numevents) * iWorker / nWorkers ;
+      const Int_t last = Long64_t(numevents) * (iWorker + 1) / nWorkers ;
+      if (!results[iWorker] || results[iWorker]->GetNrows() != (last - first) * nspec) {
+        coutE(Eval) << "SPlot Error: no pdf values received from worker " << iWorker << std::endl ;
+        evaluated = kFALSE ;
+      } else {
+        const Double_t* in = results[iWorker]->GetMatrixArray() ;
+        for (Int_t ievt = first; ievt < last; ++ievt)
+          std::copy(in + (ievt-first)*nspec, in + (ievt-first+1)*nspec, pdfvalues[ievt].begin()) ;
+      }
+      delete results[iWorker] ;
     }
+    if (!evaluated) {
+      coutW(Eval) << "SPlot: evaluating species pdfs serially" << std::endl ;
+    }
+  }
+#endif
+
+  if (!evaluated) {
+    for (Int_t ievt = 0; ievt < numevents; ievt++)
+      evalPdfValues(ievt, ievt+1, pdfvalues[ievt].data()) ;
+  }
   delete pdfvars;
 
   // check that the likelihood normalization is fine
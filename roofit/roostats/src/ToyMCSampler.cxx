@@ -51,6 +51,11 @@ ToyMCStudy with the RooStudyManager.
 
 #include "TMath.h"
 
+#ifndef _WIN32
+#include "ROOT/TProcessExecutor.hxx"
+#include "ROOT/TSeq.hxx"
+#endif
+
 
 using namespace RooFit;
 using namespace std;
@@ -84,6 +89,16 @@ void NuisanceParametersSampler::NextPoint(RooArgSet& nuisPoint, Double_t& weight
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Skips the next nPoints nuisance parameter points, as if NextPoint() had
+/// been called nPoints times.
+
+void NuisanceParametersSampler::Skip(Int_t nPoints) {
+   RooArgSet dummy;
+   Double_t weight;
+   for (Int_t i = 0; i < nPoints; ++i) NextPoint(dummy, weight);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Creates the initial set of nuisance parameter points. It also refills the
 /// set with new parameter points if called repeatedly. This helps with
@@ -176,6 +191,10 @@ ToyMCSampler::ToyMCSampler() : fSamplingDistName("SD"), fNToys(1)
    fProtoData = NULL;
 
    fProofConfig = NULL;
+   fNWorkers = 1;
+   fToySeed = 0;
+   fFirstToy = 0;
+   fNToysTotal = 0;
    fNuisanceParametersSampler = NULL;
 
    _allVars = NULL ;
@@ -216,6 +235,10 @@ ToyMCSampler::ToyMCSampler(TestStatistic &ts, Int_t ntoys) : fSamplingDistName(t
    fProtoData = NULL;
 
    fProofConfig = NULL;
+   fNWorkers = 1;
+   fToySeed = 0;
+   fFirstToy = 0;
+   fNToysTotal = 0;
    fNuisanceParametersSampler = NULL;
 
    _allVars = NULL ;
@@ -328,8 +351,11 @@ RooDataSet* ToyMCSampler::GetSamplingDistributions(RooArgSet& paramPointIn)
 {
 
    // ======= S I N G L E   R U N ? =======
-   if(!fProofConfig)
+   if(!fProofConfig) {
+      if (fNWorkers > 1 && fNToys > 1)
+         return GetSamplingDistributionsLocalWorkers(paramPointIn);
       return GetSamplingDistributionsSingleWorker(paramPointIn);
+   }
 
    // ======= P A R A L L E L   R U N =======
    if (!CheckConfig()){
@@ -371,6 +397,83 @@ RooDataSet* ToyMCSampler::GetSamplingDistributions(RooArgSet& paramPointIn)
    return output;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Run the toys in fNWorkers forked local processes, as an alternative to PROOF.
+/// Each worker runs a contiguous block of toys through
+/// GetSamplingDistributionsSingleWorker(), and the sampling distributions are
+/// merged in the order of the toy numbers. Each toy is generated with a seed
+/// derived from its number and the seed set with SetToySeed() (or a seed drawn
+/// from the RooRandom generator if none was set), so that the results do not
+/// depend on the number of workers.
+
+RooDataSet* ToyMCSampler::GetSamplingDistributionsLocalWorkers(RooArgSet& paramPointIn)
+{
+#ifndef _WIN32
+   if (!CheckConfig()){
+      oocoutE((TObject*)NULL, InputArguments)
+         << "Bad COnfiguration in ToyMCSampler "
+         << endl;
+      return nullptr;
+   }
+
+   // turn adaptive sampling off if given
+   if(fToysInTails) {
+      fToysInTails = 0;
+      oocoutW((TObject*)NULL, InputArguments)
+         << "Adaptive sampling in ToyMCSampler is not supported for parallel runs."
+         << endl;
+   }
+
+   const Int_t totToys = fNToys;
+   const UInt_t origToySeed = fToySeed;
+   if (!fToySeed)
+      fToySeed = RooRandom::randomGenerator()->Integer(TMath::Limits<unsigned int>::Max());
+   const Int_t nWorkers = std::min(fNWorkers, totToys);
+
+   oocoutP((TObject*)NULL, Generation) << "ToyMCSampler: running " << totToys << " toys in " << nWorkers
+                                       << " local worker processes, toy base seed is " << fToySeed << endl;
+
+   auto runBlock = [&](UInt_t iWorker) {
+      fFirstToy = totToys * Long64_t(iWorker) / nWorkers;
+      fNToys = totToys * Long64_t(iWorker + 1) / nWorkers - fFirstToy;
+      fNToysTotal = totToys;
+      // the worker must not continue the nuisance parameter points of the parent
+      delete fNuisanceParametersSampler;
+      fNuisanceParametersSampler = NULL;
+      return GetSamplingDistributionsSingleWorker(paramPointIn);
+   };
+
+   ROOT::TProcessExecutor workers(nWorkers);
+   std::vector<RooDataSet*> results = workers.Map(runBlock, ROOT::TSeqU(nWorkers));
+
+   RooDataSet* output = NULL;
+   for (auto result : results) {
+      if (!result) {
+         oocoutE((TObject*)NULL, Generation) << "ToyMCSampler: no sampling distribution received from a worker" << endl;
+         continue;
+      }
+      if (!output) {
+         output = result;
+      } else {
+         output->append(*result);
+         delete result;
+      }
+   }
+
+   // reset the number of toys and seeding
+   fNToys = totToys;
+   fToySeed = origToySeed;
+   fFirstToy = 0;
+   fNToysTotal = 0;
+
+   return output;
+#else
+   oocoutW((TObject*)NULL, InputArguments)
+      << "Local parallel toys are not supported on this platform, running serially." << endl;
+   return GetSamplingDistributionsSingleWorker(paramPointIn);
+#endif
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// This is the main function for serial runs. It is called automatically
 /// from inside GetSamplingDistribution when no ProofConfig is given.
@@ -423,6 +526,16 @@ RooDataSet* ToyMCSampler::GetSamplingDistributionsSingleWorker(RooArgSet& paramP
       // first one.
       Double_t valueFirst = -999.0, weight = 1.0;
 
+      // reproducible toys: derive the seed of this toy from its number
+      if (fToySeed) {
+         RooRandom::randomGenerator()->SetSeed(RooRandom::derivedSeed(fToySeed, fFirstToy + i));
+         // the randomized nuisance parameter point is drawn from the seed of the toy as well
+         if (!fExpectedNuisancePar) {
+            delete fNuisanceParametersSampler;
+            fNuisanceParametersSampler = NULL;
+         }
+      }
+
       // set variables to requested parameter point
       *allVars = *saveAll; // important for example for SimpleLikelihoodRatioTestStat
 
@@ -550,7 +663,14 @@ RooAbsData* ToyMCSampler::GenerateToyData(RooArgSet& paramPoint, double& weight,
 
    // create nuisance parameter points
    if(!fNuisanceParametersSampler && fPriorNuisance && fNuisancePars) {
-      fNuisanceParametersSampler = new NuisanceParametersSampler(fPriorNuisance, fNuisancePars, fNToys, fExpectedNuisancePar);
+      if (fToySeed && !fExpectedNuisancePar) {
+         // one point per toy, drawn right after the generator was seeded for the toy
+         fNuisanceParametersSampler = new NuisanceParametersSampler(fPriorNuisance, fNuisancePars, 1, kFALSE);
+      } else {
+         // the points of a block of toys are those the toys get in a run of all toys
+         fNuisanceParametersSampler = new NuisanceParametersSampler(fPriorNuisance, fNuisancePars, fNToysTotal ? fNToysTotal : fNToys, fExpectedNuisancePar);
+         if (fFirstToy) fNuisanceParametersSampler->Skip(fFirstToy);
+      }
       if ((fUseMultiGen || fgAlwaysUseMultiGen) &&  fNuisanceParametersSampler )
          oocoutI((TObject*)NULL,InputArguments) << "Cannot use multigen when nuisance parameters vary for every toy" << endl;
    }
@@ -0,0 +1,104 @@
+#include <RooStats/HypoTestInverter.h>
+#include <RooStats/HypoTestInverterResult.h>
+#include <RooStats/AsymptoticCalculator.h>
+#include <RooStats/FrequentistCalculator.h>
+#include <RooStats/ModelConfig.h>
+#include <RooWorkspace.h>
+#include <RooRealVar.h>
+#include <RooDataSet.h>
+#include <RooArgSet.h>
+#include <RooRandom.h>
+#include <RooMsgService.h>
+
+#include <memory>
+
+#include "gtest/gtest.h"
+
+using namespace RooStats;
+
+// Counting experiment with signal strength mu, a signal of 5 and a background of 3 events
+class HypoTestInverterScan : public ::testing::Test {
+protected:
+   void SetUp() override
+   {
+      RooMsgService::instance().setGlobalKillBelow(RooFit::ERROR);
+
+      fWs.reset(new RooWorkspace("w"));
+      fWs->factory("expr::nexp('mu*5+3',mu[1,0,10])");
+      fWs->factory("Poisson::pdf(n[0,100],nexp)");
+      RooRealVar *n = fWs->var("n");
+      RooRealVar *mu = fWs->var("mu");
+
+      fData.reset(new RooDataSet("data", "data", RooArgSet(*n)));
+      n->setVal(6);
+      fData->add(RooArgSet(*n));
+
+      fSbModel.reset(new ModelConfig("sbModel", fWs.get()));
+      fSbModel->SetPdf("pdf");
+      fSbModel->SetObservables("n");
+      fSbModel->SetParametersOfInterest("mu");
+      mu->setVal(1);
+      fSbModel->SetSnapshot(RooArgSet(*mu));
+
+      fBModel.reset(static_cast<ModelConfig *>(fSbModel->Clone("bModel")));
+      mu->setVal(0);
+      fBModel->SetSnapshot(RooArgSet(*mu));
+   }
+
+   // Compare the results of two scans point by point
+   static void Compare(const HypoTestInverterResult &first, const HypoTestInverterResult &second)
+   {
+      ASSERT_EQ(first.ArraySize(), second.ArraySize());
+      for (int i = 0; i < first.ArraySize(); ++i) {
+         EXPECT_EQ(first.GetXValue(i), second.GetXValue(i));
+         EXPECT_DOUBLE_EQ(first.CLs(i), second.CLs(i)) << "point " << i;
+         EXPECT_DOUBLE_EQ(first.CLsplusb(i), second.CLsplusb(i)) << "point " << i;
+      }
+   }
+
+   std::unique_ptr<RooWorkspace> fWs;
+   std::unique_ptr<RooDataSet> fData;
+   std::unique_ptr<ModelConfig> fSbModel;
+   std::unique_ptr<ModelConfig> fBModel;
+};
+
+// The parallel scan gives the same results as the serial scan
+TEST_F(HypoTestInverterScan, AsymptoticParallelEqualsSerial)
+{
+   auto scan = [&](int nWorkers) {
+      AsymptoticCalculator calc(*fData, *fBModel, *fSbModel);
+      calc.SetOneSided(true);
+      HypoTestInverter inverter(calc, fWs->var("mu"), 0.05);
+      inverter.UseCLs(true);
+      inverter.SetFixedScan(6, 0.5, 3.);
+      inverter.SetNWorkers(nWorkers);
+      return std::unique_ptr<HypoTestInverterResult>(inverter.GetInterval());
+   };
+
+   auto serial = scan(1);
+   auto parallel = scan(3);
+   ASSERT_TRUE(serial && parallel);
+   ASSERT_EQ(serial->ArraySize(), 6);
+   Compare(*serial, *parallel);
+}
+
+// With toys, the results of a parallel scan do not depend on the number of workers
+TEST_F(HypoTestInverterScan, FrequentistWorkerIndependent)
+{
+   auto scan = [&](int nWorkers) {
+      FrequentistCalculator calc(*fData, *fBModel, *fSbModel);
+      calc.SetToys(50, 50);
+      HypoTestInverter inverter(calc, fWs->var("mu"), 0.05);
+      inverter.UseCLs(true);
+      inverter.SetFixedScan(4, 0.5, 3.);
+      inverter.SetNWorkers(nWorkers);
+      RooRandom::randomGenerator()->SetSeed(111);
+      return std::unique_ptr<HypoTestInverterResult>(inverter.GetInterval());
+   };
+
+   auto two = scan(2);
+   auto four = scan(4);
+   ASSERT_TRUE(two && four);
+   ASSERT_EQ(two->ArraySize(), 4);
+   Compare(*two, *four);
+}
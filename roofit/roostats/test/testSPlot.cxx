@@ -0,0 +1,63 @@
+#include <RooStats/SPlot.h>
+#include <RooRealVar.h>
+#include <RooGaussian.h>
+#include <RooExponential.h>
+#include <RooAddPdf.h>
+#include <RooDataSet.h>
+#include <RooArgList.h>
+#include <RooRandom.h>
+#include <RooMsgService.h>
+
+#include <memory>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using namespace RooStats;
+
+// Compute the signal sWeights of a signal plus background sample
+static std::vector<Double_t> SignalWeights(Int_t nWorkers)
+{
+   RooRealVar x("x", "x", 0, 10);
+   RooRealVar mean("mean", "mean", 5, 0, 10);
+   RooRealVar sigma("sigma", "sigma", 0.8, 0.1, 5);
+   RooGaussian sig("sig", "sig", x, mean, sigma);
+   RooRealVar tau("tau", "tau", -0.3, -5., 0.);
+   RooExponential bkg("bkg", "bkg", x, tau);
+   // The yield ranges do not include 0, they are extended by SPlot
+   RooRealVar nsig("nsig", "nsig", 200, 10, 1000);
+   RooRealVar nbkg("nbkg", "nbkg", 300, 10, 1000);
+   RooAddPdf model("model", "model", RooArgList(sig, bkg), RooArgList(nsig, nbkg));
+
+   RooRandom::randomGenerator()->SetSeed(1234);
+   std::unique_ptr<RooDataSet> data(model.generate(x));
+
+   sigma.setConstant();
+   mean.setConstant();
+   tau.setConstant();
+
+   SPlot splot("splot", "splot", *data);
+   splot.SetNWorkers(nWorkers);
+   splot.AddSWeight(&model, RooArgList(nsig, nbkg));
+
+   std::vector<Double_t> weights;
+   for (Int_t i = 0; i < data->numEntries(); ++i) {
+      weights.push_back(splot.GetSWeight(i, "nsig_sw"));
+   }
+   return weights;
+}
+
+// The sWeights do not depend on the number of processes evaluating the species pdfs
+TEST(SPlot, ParallelWeightsReproducible)
+{
+   RooMsgService::instance().setGlobalKillBelow(RooFit::WARNING);
+
+   std::vector<Double_t> serial = SignalWeights(1);
+   std::vector<Double_t> parallel = SignalWeights(3);
+
+   ASSERT_GT(serial.size(), 0u);
+   ASSERT_EQ(parallel.size(), serial.size());
+   for (std::size_t i = 0; i < serial.size(); ++i) {
+      EXPECT_DOUBLE_EQ(serial[i], parallel[i]) << "event " << i;
+   }
+}
@@ -0,0 +1,56 @@
+#include <RooStats/ToyMCSampler.h>
+#include <RooStats/MaxLikelihoodEstimateTestStat.h>
+#include <RooStats/SamplingDistribution.h>
+#include <RooRealVar.h>
+#include <RooGaussian.h>
+#include <RooArgSet.h>
+#include <RooMsgService.h>
+
+#include <memory>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using namespace RooStats;
+
+// Run the toys of a sampler with a nuisance parameter prior and return the sampling distribution
+static std::vector<Double_t> RunToys(Int_t nWorkers)
+{
+   RooRealVar x("x", "x", -10, 10);
+   RooRealVar mu("mu", "mu", 0, -5, 5);
+   RooRealVar sigma("sigma", "sigma", 1, 0.1, 5);
+   RooGaussian model("model", "model", x, mu, sigma);
+   RooRealVar sigma0("sigma0", "sigma0", 1);
+   RooRealVar sigmaErr("sigmaErr", "sigmaErr", 0.2);
+   RooGaussian prior("prior", "prior", sigma, sigma0, sigmaErr);
+
+   MaxLikelihoodEstimateTestStat ts(model, mu);
+   ToyMCSampler sampler(ts, 12);
+   sampler.SetPdf(model);
+   sampler.SetObservables(RooArgSet(x));
+   sampler.SetParametersForTestStat(RooArgSet(mu));
+   sampler.SetNuisanceParameters(RooArgSet(sigma));
+   sampler.SetPriorNuisance(&prior);
+   sampler.SetNEventsPerToy(50);
+   sampler.SetToySeed(4711);
+   sampler.SetNWorkers(nWorkers);
+
+   RooArgSet point(mu, sigma);
+   std::unique_ptr<SamplingDistribution> dist(sampler.GetSamplingDistribution(point));
+   return dist->GetSamplingDistribution();
+}
+
+// The toys, including the nuisance parameter points, do not depend on the number of workers
+TEST(ToyMCSampler, ParallelToysReproducible)
+{
+   RooMsgService::instance().setGlobalKillBelow(RooFit::WARNING);
+
+   std::vector<Double_t> serial = RunToys(1);
+   std::vector<Double_t> parallel = RunToys(3);
+
+   ASSERT_EQ(serial.size(), 12u);
+   ASSERT_EQ(parallel.size(), serial.size());
+   for (std::size_t i = 0; i < serial.size(); ++i) {
+      EXPECT_EQ(serial[i], parallel[i]) << "toy " << i;
+   }
+}